@@ -24,7 +24,7 @@ function(make_hw_test TEST_DIR)
     get_filename_component(TEST_NAME ${TEST_DIR} NAME)
 
     # Collect all test files
-    file(GLOB TEST_FILES RELATIVE ${CMAKE_CURRENT_LIST_DIR} CONFIGURE_DEPENDS ${TEST_DIR}/*.c ${TEST_DIR}/*.h )
+    file(GLOB TEST_FILES RELATIVE ${CMAKE_CURRENT_LIST_DIR} CONFIGURE_DEPENDS ${TEST_DIR}/*.c ${TEST_DIR}/*.h ${TEST_DIR}/*.gdb )
 
     # Figure out what is what?
     foreach(TEST_FILE ${TEST_FILES})
@@ -35,7 +35,7 @@ function(make_hw_test TEST_DIR)
         else()
             # debug.gdb will override the default GDB file
             if ("${FILE_NAME}" STREQUAL "debug.gdb")
-                set(GDB_FILE ${TEST_FILE})
+                set(GDB_FILE ${CMAKE_CURRENT_LIST_DIR}/${TEST_FILE})
             else()
                 # Any other .c file is expected to be an application
                 get_filename_component(FILE_EXT "${TEST_FILE}" EXT)
@@ -60,15 +60,23 @@ function(make_hw_test TEST_DIR)
         message(STATUS "\t${TEST_NAME} has application ${APP_NAME}")
         add_application(${APP_NAME} ${APP_SRCS})
         target_include_directories(${APP_NAME} PRIVATE ${CMAKE_CURRENT_LIST_DIR})
-        target_link_libraries(${APP_NAME} os stdlib aux_systick test_platform)
+        target_link_libraries(${APP_NAME} os stdlib bsw_com aux_systick test_platform)
         #target_link_libraries(${APP_NAME} os)
         target_add_applications(${TEST_NAME} ${APP_NAME})
     endforeach()
 
     target_link_libraries(${TEST_NAME} test_platform_main)
     message(STATUS "Added test ${TEST_NAME}")
+    if (CMRX_QEMU_PATH)
+        # Run test in emulator, QEMU loads the firmware itself. Virtual
+        # clock is driven by instruction count, so that SysTick-based
+        # benchmark measurements are deterministic.
+        set(GDB_TARGET -ex "target remote | ${CMRX_QEMU_PATH} -M ${CMRX_QEMU_MACHINE} -nographic -icount shift=0 -S -gdb stdio -kernel $<TARGET_FILE:${TEST_NAME}>" -ex "set $_CMRX_TARGET_RUN = 0")
+    else()
+        set(GDB_TARGET -x ${CMAKE_CURRENT_LIST_DIR}/openocd.gdb)
+    endif()
     add_test(NAME ${TEST_NAME}
-        COMMAND ${CMRX_GDB_PATH} -x ${GDB_FILE} $<TARGET_FILE:${TEST_NAME}>
+        COMMAND ${CMRX_GDB_PATH} ${GDB_TARGET} -x ${GDB_FILE} $<TARGET_FILE:${TEST_NAME}>
         WORKING_DIRECTORY ${CMAKE_SOURCE_DIR})
     set_tests_properties(${TEST_NAME} PROPERTIES TIMEOUT 5)
 endfunction()
@@ -34,6 +34,103 @@
 #define OS_PROCESSES 			8
 
 /** How many sleeping threads can exist */
-#define SLEEPERS_MAX			(2 * OS_THREADS)
+#define SLEEPERS_MAX			(3 * OS_THREADS)
+
+/** Queue signals sent using sigqueue().
+ * If defined, each thread owns a bounded queue of signals, each carrying
+ * 32-bit value. Queued signals don't collapse into each other. If not defined,
+ * sigqueue() behaves like kill() and value passed is lost.
+ */
+#define KERNEL_HAS_SIGNAL_QUEUE
+
+/** How many queued signals can be pending for one thread */
+#define OS_SIGNAL_QUEUE_DEPTH	4
+
+/** How many notification counters each thread has */
+#define OS_THREAD_NOTIFICATIONS	2
+
+/** How many objects can thread wait for at once using wait_objects() */
+#define OS_WAIT_OBJECTS			4
+
+/** How many event groups can exist at once */
+#define OS_EVENT_GROUPS			8
+
+/** How many message queues can exist at once */
+#define OS_MQUEUES				4
+
+/** How many message slots are shared by all message queues.
+ * Each queue reserves as many slots as is its depth when it is created.
+ * At most 32 slots are supported.
+ */
+#define OS_MQUEUE_SLOTS			16
+
+/** Size of one message slot in bytes.
+ * Has to be power of two, so that slot can be mapped by MPU for zero-copy
+ * receive. At least 32 bytes, at least 256 bytes on ARMv6-M.
+ */
+#ifdef __ARM_ARCH_6M__
+#	define OS_MQUEUE_SLOT_SIZE		256
+#else
+#	define OS_MQUEUE_SLOT_SIZE		64
+#endif
+
+/** How many buffers are there in zero-copy buffer pool.
+ * Pool is covered by single MPU region, where each buffer occupies one
+ * subregion. At most 8 buffers are supported.
+ */
+#define OS_BUFFERS				8
+
+/** Size of one pool buffer in bytes.
+ * Has to be power of two and at least 32 bytes.
+ */
+#define OS_BUFFER_SIZE			256
+
+/** How many shared memory windows can exist at once.
+ * Each process can take part in at most one window.
+ */
+#define OS_SHMEM_WINDOWS		4
+
+/** How many requests can interrupt service routines post to kernel at once.
+ * Requests are processed next time kernel gets to run. Must be power of two.
+ */
+#define OS_ISR_REQUESTS			16
+
+/** How many asynchronous RPC requests can be queued at once.
+ * This is a system-wide limit shared by all processes. Slot is occupied
+ * from the moment the request is queued until its caller collects the result.
+ */
+#define OS_RPC_REQUESTS			8
+
+/** How many RPC requests can be pending for one process at once.
+ * Once this limit is reached, further queued or asynchronous calls
+ * to services of the process fail until workers catch up.
+ */
+#define OS_RPC_QUEUE_DEPTH		4
+
+/** Collect statistics of synchronous RPC calls.
+ * If defined, kernel counts calls and measures time spent in each RPC method.
+ * This adds some overhead to each RPC call and return.
+ */
+/* #define KERNEL_HAS_RPC_STATISTICS */
+
+/** Record synchronous RPC calls and returns into trace buffer.
+ */
+/* #define KERNEL_HAS_RPC_TRACE */
+
+/** Collect lock contention statistics.
+ * If defined, futex lock and unlock report to kernel, which counts
+ * acquisitions and measures wait and hold times of each lock. This makes
+ * every lock and unlock a system call.
+ */
+/* #define KERNEL_HAS_LOCK_PROFILE */
+
+/** How many distinct locks contention statistics are collected for */
+#define OS_LOCK_PROFILE_ENTRIES	32
+
+/** How many distinct RPC methods statistics are collected for */
+#define OS_RPC_STATS_ENTRIES	32
+
+/** How many events RPC trace buffer can hold */
+#define OS_RPC_TRACE_SIZE		128
 
 /** @} */
@@ -83,4 +83,24 @@ __attribute__((externally_visible, used, section(".thread_create") )) const stru
 	priority\
 }
 
+/** RPC worker thread autostart facility.
+ *
+ * Use this to create worker thread which executes RPC calls made using
+ * @ref rpc_call_queued() on services owned by the application. Calls are
+ * executed at the priority of the worker and on its stack, rather than on the
+ * stack of the calling thread. Use this macro multiple times with different
+ * names to create pool of workers.
+ * @param application name of process/application worker belongs to.
+ * @param name unique name of the worker within the application
+ * @param priority priority at which RPC calls will be executed
+ */
+#define OS_RPC_WORKER(application, name, priority) \
+extern int rpc_worker(void *);\
+__attribute__((externally_visible, used, section(".thread_create") )) const struct OS_thread_create_t __APPL_SYMBOL(application, rpc_worker_ ## name) = {\
+	&__APPL_SYMBOL(application, instance),\
+	rpc_worker,\
+	NULL,\
+	priority\
+}
+
 /** @} */
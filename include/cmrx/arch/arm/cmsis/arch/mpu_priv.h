@@ -28,6 +28,7 @@
 /** @defgroup arm_mpu_registers ARM MPU register aliases
  * @{
  */
+#define MPU_TYPE (MPU->TYPE)
 #define MPU_CTRL (MPU->CTRL)
 #define MPU_RNR (MPU->RNR)
 #define MPU_RASR (MPU->RASR)
@@ -62,6 +63,13 @@
 #define MPU_RBAR_REGION_LSB (MPU_RBAR_REGION_Pos)
 /** @} */
 
+/** @defgroup arm_mpu_type ARM MPU TYPE fields
+ * @{ 
+ */
+#define MPU_TYPE_DREGION (MPU_TYPE_DREGION_Msk)
+#define MPU_TYPE_DREGION_LSB (MPU_TYPE_DREGION_Pos)
+/** @} */
+
 /** @defgroup arm_mpu_ctrl ARM MPU CTRL fields
  * @{ 
  */
@@ -86,10 +94,10 @@
 #define OS_MPU_REGION_MMIO			2
 /// Region containing shared/sharable resources
 #define OS_MPU_REGION_MMIO2 		3
-/// Currently unused region (reserved)
-#define OS_MPU_REGION_SHARED		4
-/// Currently unused region (reserved)
-#define OS_MPU_REGION_UNUSED2		5
+/// Region covering buffers owned by process of running thread
+#define OS_MPU_REGION_BUFFERS		4
+/// Region covering memory window of running thread
+#define OS_MPU_REGION_WINDOW		5
 /// Region covering thread's stack
 #define OS_MPU_REGION_STACK			6
 /// Region covering executable RAM (?)
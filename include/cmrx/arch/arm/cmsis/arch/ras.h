@@ -0,0 +1,45 @@
+#pragma once
+
+/** @defgroup arch_arm_ras Restartable atomic sequences
+ * @ingroup arch_arm
+ *
+ * ARMv6-M lacks exclusive access instructions. Userspace atomic operations
+ * are implemented as short code sequences instead. If thread is switched
+ * out while executing such sequence, kernel rewinds its PC back to the
+ * start of the sequence, so the sequence is re-executed from scratch once
+ * thread is resumed. Sequences are thus atomic with respect to other threads.
+ * They are not atomic with respect to interrupt service routines.
+ *
+ * Kernel also restarts the sequence if it serviced requests of interrupt
+ * service routines without switching threads, as these requests may modify
+ * words accessed by the sequence.
+ *
+ * Sequence must only read its inputs until its last instruction, which
+ * performs the store. Sequences are registered in the `.ras_table` section
+ * using @ref RAS_REGISTER.
+ * @{
+ */
+
+#include <stdint.h>
+
+/** Register restartable atomic sequence.
+ * Expands to assembler directives which record the sequence into the table
+ * of sequences known to the kernel. Use inside assembler block which defines
+ * the sequence.
+ * @param start label marking the first instruction of the sequence
+ * @param end label marking the first instruction after the sequence
+ */
+#define RAS_REGISTER(start, end) \
+	".pushsection .ras_table, \"a\"\n\t" \
+	".word " #start ", " #end "\n\t" \
+	".popsection\n\t"
+
+/** Address range of one restartable atomic sequence */
+struct RAS_sequence_t {
+	/** Address of first instruction of the sequence */
+	uint32_t start;
+	/** Address of first instruction past the sequence */
+	uint32_t end;
+};
+
+/** @} */
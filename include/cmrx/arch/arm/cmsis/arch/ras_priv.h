@@ -0,0 +1,31 @@
+#pragma once
+
+/** @addtogroup arch_arm_ras
+ *
+ * Kernel side of restartable atomic sequences. Not to be included by
+ * userspace code, as it pulls in CMSIS core headers.
+ * @{
+ */
+
+#include <arch/ras.h>
+#include <arch/cortex.h>
+
+struct OS_thread_t;
+
+/** Restart atomic sequence interrupted by thread switch.
+ * If thread was switched out while executing restartable atomic sequence,
+ * then its PC is moved back to the start of the sequence. Thread context
+ * must be saved on its stack.
+ * @param thread thread being switched out
+ */
+void os_ras_rewind(struct OS_thread_t * thread);
+
+/** Restart atomic sequence interrupted by kernel.
+ * Works as @ref os_ras_rewind() for thread whose context is not saved.
+ * Used when kernel modified memory while servicing exception which is going
+ * to return back into the same thread.
+ * @param frame exception frame of interrupted thread
+ */
+void os_ras_rewind_frame(ExceptionFrame * frame);
+
+/** @} */
@@ -0,0 +1,40 @@
+/** @defgroup api_atomic Atomic operations
+ *
+ * @ingroup api
+ *
+ * Lock-free operations on 32-bit words usable from userspace.
+ *
+ * On ARMv7-M these are implemented using exclusive access instructions.
+ * On ARMv6-M, which lacks them, these are implemented as restartable atomic
+ * sequences: if thread is switched out in the middle of operation, kernel
+ * restarts the operation once thread is resumed. No syscall is involved
+ * in either case.
+ *
+ * On ARMv6-M operations are atomic with respect to other threads only.
+ * They must not be used on words which interrupt service routines modify.
+ */
+
+/** @ingroup api_atomic
+ * @{
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Atomically replace value of word if it contains expected value.
+ * @param address address of 32-bit word
+ * @param expected value word is expected to contain
+ * @param desired value stored into word
+ * @returns true if word contained expected value and was replaced, false otherwise
+ */
+bool atomic_cas(volatile uint32_t * address, uint32_t expected, uint32_t desired);
+
+/** Atomically add value to word.
+ * @param address address of 32-bit word
+ * @param value value added to word
+ * @returns value of word before addition
+ */
+uint32_t atomic_add(volatile uint32_t * address, uint32_t value);
+
+/** @} */
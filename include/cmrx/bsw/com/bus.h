@@ -0,0 +1,211 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <cmrx/application.h>
+#include <cmrx/bsw/com/com.h>
+#include <cmrx/ipc/ring.h>
+
+/** @defgroup bsw_com_bus Publish/subscribe bus
+ *
+ * @ingroup bsw_com
+ *
+ * Topic-based distribution of samples built on top of communication abstraction.
+ *
+ * Bus is hosted by one process, which owns all topics and subscriptions. Publisher
+ * does not need to know its consumers. It writes samples into topic, which is
+ * an ordinary @ref ComSink, or publishes them using name of the topic through
+ * the bus service. Topic then fans samples out to all its subscriptions.
+ *
+ * Each subscription is an ordinary @ref ComSource read by one consumer. Consumer
+ * chooses one of two semantics when subscription is defined:
+ * * queued - every sample is stored in ring buffer of subscription. If consumer
+ *   does not keep up and ring gets full, further samples are dropped for this
+ *   consumer only.
+ * * latest value - subscription holds only the most recent sample. Samples which
+ *   were not read before newer sample arrived are overwritten. If publisher
+ *   preempts another one which is writing sample into subscription, then
+ *   sample of preempting publisher is dropped.
+ *
+ * Consumer registers its @ref COM_NOTIFICATION using `set_notify` method of
+ * the subscription. Listener is notified once per batch: after notification is
+ * sent, further samples don't notify listener again until consumer reads all
+ * the data available. Thus consumer shall read subscription until read
+ * returns 0 each time it is notified. Notifications are one-way, publisher is
+ * never blocked by consumers, see @ref com_notify().
+ *
+ * Buffers passed to `read` and `write` methods have to be accessible by the
+ * bus process during RPC call, e.g. placed in @ref SHARED section of caller.
+ *
+ * Bus is defined statically by hosting process:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~
+ * COM_BUS_SUBSCRIPTION_QUEUED(imu_logger, sizeof(struct imu_sample), 16);
+ * COM_BUS_SUBSCRIPTION_LATEST(imu_display, sizeof(struct imu_sample));
+ *
+ * COM_BUS_TOPIC(imu, "imu", sizeof(struct imu_sample), &imu_logger, &imu_display);
+ *
+ * COM_BUS(sensor_bus, &imu);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Publisher then publishes either directly into topic, or by name of topic:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~
+ *     rpc_call(&imu, write, (const uint8_t *) &sample, sizeof(sample));
+ *     rpc_call(&sensor_bus, publish, "imu", (const uint8_t *) &sample, sizeof(sample));
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ */
+
+/** Subscriber receives every sample, as long as there is space in its ring */
+#define COM_BUS_QUEUED		0
+
+/** Subscriber receives the most recent sample only */
+#define COM_BUS_LATEST		1
+
+/** Subscription of one consumer to one topic.
+ * Implements @ref ComSource interface.
+ */
+struct ComSubscription {
+	const struct ComSourceVMT * vtable;
+	/** Queued samples, NULL for latest value subscription */
+	ring_t * ring;
+	/** Storage of the most recent sample for latest value subscription */
+	uint8_t * sample;
+	/** Size of sample */
+	uint16_t sample_size;
+	/** Sequence number of the most recent sample times two, odd while it is being written */
+	volatile uint32_t sequence;
+	/** Sequence number of sample consumer read last */
+	uint32_t seen;
+	/** Nonzero if listener was notified and did not read all the data yet */
+	volatile uint32_t notified;
+	/** Amount of samples dropped because ring was full or, for latest value
+	 * subscription, because another publisher was writing sample
+	 */
+	volatile uint32_t dropped;
+	/** Listener notified about new samples */
+	struct ComNotification * listener;
+	/** Identifier passed to listener */
+	uint32_t signal;
+};
+
+/** Topic samples are published into.
+ * Implements @ref ComSink interface.
+ */
+struct ComTopic {
+	const struct ComSinkVMT * vtable;
+	/** Name of topic */
+	const char * name;
+	/** Subscriptions samples are fanned out to */
+	struct ComSubscription * const * subscriptions;
+	/** Amount of subscriptions */
+	uint8_t subscription_count;
+	/** Size of sample */
+	uint16_t sample_size;
+};
+
+/** Methods of bus service. */
+struct ComBusVMT {
+	/** Publish samples into topic given by its name.
+	 * @param topic name of topic
+	 * @param data samples
+	 * @param length size of data, multiple of sample size of topic
+	 * @returns E_OK, E_NOTAVAIL if there is no such topic, E_WRONG_SIZE if
+	 * length is not multiple of sample size
+	 */
+	int (*publish)(SELF, const char * topic, const uint8_t * data, unsigned length);
+};
+
+/** Bus - set of topics accessible by their names. */
+struct ComBus {
+	const struct ComBusVMT * vtable;
+	/** Topics of the bus */
+	struct ComTopic * const * topics;
+	/** Amount of topics */
+	uint8_t topic_count;
+};
+
+/** @cond INTERNAL */
+int com_subscription_read(SELF, uint8_t * data, unsigned max_len);
+bool com_subscription_ready(SELF);
+void com_subscription_set_notify(SELF, struct ComNotification * listener, uint32_t signal);
+int com_topic_write(SELF, const uint8_t * data, unsigned length);
+bool com_topic_free(SELF);
+int com_bus_publish(SELF, const char * topic, const uint8_t * data, unsigned length);
+
+#define __COM_BUS_SUBSCRIPTION(name, ring_ptr, sample_ptr, size) \
+static VTABLE struct ComSourceVMT name ## _vmt = {\
+	&com_subscription_read,\
+	&com_subscription_ready,\
+	&com_subscription_set_notify\
+};\
+\
+struct ComSubscription name = {\
+	.vtable = & name ## _vmt,\
+	.ring = (ring_ptr),\
+	.sample = (sample_ptr),\
+	.sample_size = (size),\
+	.listener = NULL\
+}
+/** @endcond */
+
+/** Define subscription which queues samples.
+ * @param name name of subscription instance
+ * @param size size of sample, has to match topic
+ * @param depth amount of samples queued, power of two
+ */
+#define COM_BUS_SUBSCRIPTION_QUEUED(name, size, depth) \
+static uint8_t name ## _storage[(depth) * (size)];\
+static ring_t name ## _ring = RING_STATIC_INIT(name ## _storage, size, depth);\
+__COM_BUS_SUBSCRIPTION(name, &name ## _ring, NULL, size)
+
+/** Define subscription which keeps the most recent sample only.
+ * @param name name of subscription instance
+ * @param size size of sample, has to match topic
+ */
+#define COM_BUS_SUBSCRIPTION_LATEST(name, size) \
+static uint8_t name ## _storage[(size)];\
+__COM_BUS_SUBSCRIPTION(name, NULL, name ## _storage, size)
+
+/** Define topic.
+ * @param name name of topic instance
+ * @param topic_name name used to publish into topic through the bus
+ * @param size size of sample
+ * @param ... addresses of subscriptions of topic
+ */
+#define COM_BUS_TOPIC(name, topic_name, size, ...) \
+static VTABLE struct ComSinkVMT name ## _vmt = {\
+	&com_topic_write,\
+	&com_topic_free\
+};\
+\
+static struct ComSubscription * const name ## _subscriptions[] = { __VA_ARGS__ };\
+\
+struct ComTopic name = {\
+	& name ## _vmt,\
+	(topic_name),\
+	name ## _subscriptions,\
+	sizeof(name ## _subscriptions) / sizeof(name ## _subscriptions[0]),\
+	(size)\
+}
+
+/** Define bus.
+ * @param name name of bus instance
+ * @param ... addresses of topics of bus
+ */
+#define COM_BUS(name, ...) \
+static VTABLE struct ComBusVMT name ## _vmt = {\
+	&com_bus_publish\
+};\
+\
+static struct ComTopic * const name ## _topics[] = { __VA_ARGS__ };\
+\
+struct ComBus name = {\
+	& name ## _vmt,\
+	name ## _topics,\
+	sizeof(name ## _topics) / sizeof(name ## _topics[0])\
+}
+
+/** @} */
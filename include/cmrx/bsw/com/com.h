@@ -2,7 +2,13 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include <cmrx/interface.h>
+#include <cmrx/rpc/interface.h>
+#include <cmrx/ipc/rpc.h>
+
+#ifndef SELF
+/** First argument of communication interface methods, see @ref INSTANCE() */
+#	define SELF INSTANCE(this)
+#endif
 /** @defgroup bsw_com Communication abstraction
  *
  * @ingroup libs
@@ -132,6 +138,18 @@ struct ComNotification {
 	Thread_t thread_id;
 };
 
+/** Notify listener of data availability without waiting for it.
+ * Sends one-way notification to listener registered using `set_notify`.
+ * Unlike calling `readable_notify` using @ref rpc_call(), the caller is not
+ * blocked while listener handles the notification. Repeated notifications
+ * carrying the same id are merged while listener did not handle them yet.
+ * Listener process has to run server thread, see @ref OS_RPC_WORKER().
+ * @param listener listener registered by consumer
+ * @param id identifier passed to the listener
+ * @returns E_OK if notification was queued, negative error code otherwise
+ */
+#define com_notify(listener, id) rpc_notify((listener), readable_notify, (uint32_t) (id))
+
 struct ComSource;
 
 /** Methods implemented by the interface of class ComSource
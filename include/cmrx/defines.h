@@ -18,6 +18,11 @@
 #include <stdint.h>
 
 /** @defgroup api_errors Named constants for errors
+ *
+ * Calls which only report their outcome return E_OK or one of these codes.
+ * Calls which return handle, index, count or other non-negative value
+ * return negative value of these codes if they fail, so that failure can't
+ * be mistaken for valid value.
  * @{
  */
 #define E_OK					0
@@ -32,8 +37,13 @@
 #define E_NOTAVAIL				9
 #define E_INVALID				10
 #define E_IN_TOO_DEEP			11
+#define E_TIMEOUT				12
+#define E_DELETED				13
 /** @} */
 
+/** Timeout value meaning that caller waits until the condition is met, no matter how long it takes. */
+#define WAIT_FOREVER			0xFFFFFFFF
+
 /** Name the null pointer.
  * NULL is not a C name, rather than POSIX one. Introduce it here so we can
  * have a named null pointer rather than a magic constant.
@@ -46,6 +56,17 @@ typedef uint8_t Thread_t;
 /** Data type used for process IDs */
 typedef uint8_t Process_t;
 
+/** Signal number meaning that no signal shall be delivered on completion.
+ * Use this as `signal` argument of @ref rpc_call_async() if completion will be
+ * checked by polling only.
+ */
+#define RPC_NO_SIGNAL			0xFF
+
+/** Flag marking asynchronous call as one-way notification.
+ * Passed in place of signal to @ref _rpc_call_async() by @ref rpc_notify().
+ */
+#define RPC_NOTIFY_FLAG			0x100
+
 /** @} */
 /** @} */
 
@@ -0,0 +1,65 @@
+/** @defgroup api_buffer Buffer pool
+ *
+ * @ingroup api
+ *
+ * Kernel-managed pool of fixed-size buffers passed between processes
+ * without copying.
+ *
+ * Each buffer is owned by at most one process at a time and only threads
+ * of the owning process can access it. Owner can hand buffer over to
+ * another process. Kernel then removes buffer from owner's address space
+ * and adds it into address space of the recipient. Buffer contents are
+ * never copied, only the handle of buffer has to be passed to recipient,
+ * for example using message queue or RPC call.
+ *
+ * Pool has @ref OS_BUFFERS buffers of @ref OS_BUFFER_SIZE bytes each. Pool
+ * is mapped into thread's address space using MPU region of its own, so
+ * buffers stay accessible while thread has a message mapped using
+ * @ref mqueue_receive_map().
+ *
+ * Buffers are owned by the process of calling thread. Thus buffers can be
+ * accessed during RPC calls the same way as memory of process marked as
+ * shared.
+ */
+
+/** @ingroup api_buffer
+ * @{
+ */
+#pragma once
+
+#include <arch/sysenter.h>
+#include <cmrx/defines.h>
+
+/** Allocate buffer.
+ * Buffer is owned by the process of calling thread and becomes accessible
+ * immediately. Contents of buffer are not cleared.
+ * @returns handle of buffer if it was allocated. Negative value of
+ * E_OUT_OF_RANGE if all buffers are in use.
+ */
+__SYSCALL int buffer_alloc(void);
+
+/** Get address of buffer.
+ * @param buffer handle of buffer
+ * @returns address of buffer if it is owned by the process of calling thread,
+ * NULL otherwise
+ */
+__SYSCALL void * buffer_address(int buffer);
+
+/** Hand buffer over to another process.
+ * Ownership of buffer is transferred to the process of given thread. Buffer
+ * is not accessible by the caller anymore.
+ * @param buffer handle of buffer
+ * @param thread any thread of the recipient process
+ * @returns E_OK if buffer was handed over, E_INVALID if buffer is not owned
+ * by the process of calling thread or thread does not exist.
+ */
+__SYSCALL int buffer_send(int buffer, Thread_t thread);
+
+/** Return buffer to pool.
+ * @param buffer handle of buffer
+ * @returns E_OK if buffer was freed, E_INVALID if buffer is not owned by the
+ * process of calling thread.
+ */
+__SYSCALL int buffer_free(int buffer);
+
+/** @} */
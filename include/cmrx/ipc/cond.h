@@ -0,0 +1,72 @@
+/** @defgroup api_cond Condition variables
+ *
+ * @ingroup api
+ *
+ * Condition variables allow threads to sleep until other thread announces
+ * that some condition protected by futex might have changed.
+ *
+ * Condition variable is always used together with futex. Thread waiting
+ * for condition holds the futex, which is released while thread sleeps
+ * and locked again before @ref cond_wait() returns. Waiters are woken up
+ * in order of their priority.
+ *
+ * Broadcast wakes only one waiter. Other waiters are moved to sleep on the
+ * futex and are woken one by one as futex gets unlocked. This avoids all
+ * waiters competing for the futex at once.
+ */
+
+/** @ingroup api_cond
+ * @{
+ */
+#pragma once
+
+#include <stdint.h>
+#include <cmrx/ipc/mutex.h>
+
+/** Compile time initialization of condition variable.
+ * If condition variable is initialized using this value, then it is not
+ * necessary to call cond_init() during runtime.
+ */
+#define COND_STATIC_INIT		{ 0, NULL }
+
+/** Condition variable structure */
+typedef struct {
+	/** Sequence number changed by each signal and broadcast */
+	uint32_t sequence;
+	/** Futex used by waiters */
+	futex_t * futex;
+} cond_t;
+
+/** Initialize condition variable.
+ * @param cond condition variable
+ * @returns 0
+ */
+int cond_init(cond_t * cond);
+
+/** Wait for condition variable to be signalled.
+ * Atomically releases futex and blocks calling thread until condition
+ * variable is signalled. Futex is locked again before call returns,
+ * even if wait timed out. Caller must hold the futex. All threads waiting
+ * for the same condition variable must use the same futex.
+ * Spurious wakeups are possible, caller shall check the condition again.
+ * @param cond condition variable
+ * @param futex futex protecting the condition, locked by caller
+ * @param timeout_us maximal time to wait in microseconds, WAIT_FOREVER to wait without timeout
+ * @returns E_OK if thread was woken up, E_TIMEOUT if wait timed out
+ */
+int cond_wait(cond_t * cond, futex_t * futex, unsigned timeout_us);
+
+/** Wake one thread waiting for condition variable.
+ * @param cond condition variable
+ * @returns 0
+ */
+int cond_signal(cond_t * cond);
+
+/** Wake all threads waiting for condition variable.
+ * Highest priority waiter is woken up, others are moved to the futex.
+ * @param cond condition variable
+ * @returns 0
+ */
+int cond_broadcast(cond_t * cond);
+
+/** @} */
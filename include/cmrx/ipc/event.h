@@ -0,0 +1,86 @@
+/** @defgroup api_event Event groups
+ *
+ * @ingroup api
+ *
+ * API for waiting on combination of events.
+ *
+ * Event group is a kernel object holding 32 flags. Threads can set and clear
+ * flags and wait until either any or all flags from given mask are set.
+ * Interrupt service routines can set flags using @ref isr_event_group_set().
+ *
+ * If multiple threads wait on the same event group, then they are examined
+ * in order of their priority, highest first. Waiter which requested flags
+ * to be cleared on wakeup consumes them and threads examined after it
+ * won't see them anymore.
+ */
+
+/** @ingroup api_event
+ * @{
+ */
+#pragma once
+
+#include <stdint.h>
+#include <arch/sysenter.h>
+#include <cmrx/defines.h>
+
+/** Wake up if any of flags is set */
+#define EVENT_WAIT_ANY			0
+
+/** Wake up only if all flags are set */
+#define EVENT_WAIT_ALL			1
+
+/** Clear flags waited for once thread is woken up */
+#define EVENT_WAIT_CLEAR		2
+
+/** Create new event group.
+ * Event group is created with all flags cleared. It is owned by the process
+ * of calling thread.
+ * @returns handle of event group if it was created, negative value of
+ * E_OUT_OF_RANGE if all event groups are in use.
+ */
+__SYSCALL int event_group_create(void);
+
+/** Delete event group.
+ * Threads waiting on the event group are woken up. They get E_DELETED, or
+ * negative value of E_DELETED if they wait using @ref wait_objects().
+ * @param group handle of event group
+ * @returns E_OK if event group was deleted, E_INVALID if handle is not valid
+ * or event group is owned by another process.
+ */
+__SYSCALL int event_group_delete(int group);
+
+/** Set flags of event group.
+ * All threads whose wait condition becomes satisfied are woken up.
+ * @param group handle of event group
+ * @param bits flags to be set
+ * @returns E_OK if flags were set, E_INVALID if handle is not valid.
+ */
+__SYSCALL int event_group_set(int group, uint32_t bits);
+
+/** Clear flags of event group.
+ * @param group handle of event group
+ * @param bits flags to be cleared
+ * @returns E_OK if flags were cleared, E_INVALID if handle is not valid.
+ */
+__SYSCALL int event_group_clear(int group, uint32_t bits);
+
+/** Wait for flags of event group.
+ *
+ * Blocks calling thread until any or all flags in mask are set. If condition
+ * is already satisfied, then call returns immediately.
+ * @param group handle of event group
+ * @param bits on entry mask of flags thread waits for. If condition got
+ * satisfied, then flags of event group at that moment, before they were
+ * cleared, are stored here. Left untouched otherwise.
+ * @param flags EVENT_WAIT_ANY or EVENT_WAIT_ALL, optionally combined with
+ * EVENT_WAIT_CLEAR
+ * @param timeout_us maximal time to wait in microseconds. 0 means that only
+ * current state of flags is examined, WAIT_FOREVER waits without timeout.
+ * @returns E_OK if condition got satisfied, E_TIMEOUT if wait timed out,
+ * E_DELETED if event group was deleted while thread waited, E_INVALID if
+ * handle is not valid or mask is empty, E_MISALIGNED if bits is not aligned,
+ * E_INVALID_ADDRESS if calling thread can't write to bits.
+ */
+__SYSCALL int event_group_wait(int group, uint32_t * bits, unsigned flags, unsigned timeout_us);
+
+/** @} */
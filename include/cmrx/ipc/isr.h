@@ -12,19 +12,84 @@
  * then either pass the CPU to the interrupted thread, or wake up some specific thread to
  * finish the work.
  * Calls present in this section are not system calls, can only be called from interrupt
- * handler context.
+ * handler context. Their effect is deferred until the kernel gets to run after all
+ * interrupt service routines finished.
  * @{
  */
 
 #include <cmrx/defines.h>
+#include <cmrx/ipc/sem.h>
 #include <stdint.h>
 
 /** Send signal from ISR context.
  * This routine is an equivalent of \ref kill() syscall, which
- * is usable from interrupt service routine context.
+ * is usable from interrupt service routine context. Only catchable
+ * signals can be sent.
  * @param thread_id thread, which should receive the signal
  * @param signal signal to be sent
+ * @returns E_OK if request was posted to kernel, E_INVALID if arguments
+ * are out of range, E_BUSY if too many requests are pending.
  */
-void isr_kill(Thread_t thread_id, uint32_t signal);
+int isr_kill(Thread_t thread_id, uint32_t signal);
+
+/** Resume stopped thread from ISR context.
+ * This routine is an equivalent of sending SIGCONT using \ref kill(),
+ * which is usable from interrupt service routine context.
+ * @param thread_id thread, which should be resumed
+ * @returns E_OK if request was posted to kernel, E_INVALID if thread ID
+ * is out of range, E_BUSY if too many requests are pending.
+ */
+int isr_thread_continue(Thread_t thread_id);
+
+/** Wake threads waiting for futex from ISR context.
+ * This routine is an equivalent of \ref futex_wake() syscall,
+ * which is usable from interrupt service routine context.
+ * @param address address of futex word
+ * @param count maximal amount of threads woken up
+ * @returns E_OK if request was posted to kernel, E_BUSY if too many
+ * requests are pending.
+ */
+int isr_futex_wake(uint32_t * address, uint8_t count);
+
+/** Set flags of event group from ISR context.
+ * This routine is an equivalent of \ref event_group_set() syscall,
+ * which is usable from interrupt service routine context.
+ * @param group event group handle
+ * @param bits flags to be set
+ * @returns E_OK if request was posted to kernel, E_INVALID if handle
+ * is out of range, E_BUSY if too many requests are pending.
+ */
+int isr_event_group_set(int group, uint32_t bits);
+
+/** Give notification to thread from ISR context.
+ * This routine is an equivalent of \ref notify_give() syscall,
+ * which is usable from interrupt service routine context.
+ * @param thread_id thread receiving the notification
+ * @param index index of notification counter
+ * @returns E_OK if request was posted to kernel, E_INVALID if thread
+ * or index is out of range, E_BUSY if too many requests are pending.
+ */
+int isr_notify_give(Thread_t thread_id, unsigned index);
+
+/** Give one unit to semaphore from ISR context.
+ * This routine is an equivalent of \ref sem_give(),
+ * which is usable from interrupt service routine context.
+ * Semaphore is updated once kernel gets to process the request.
+ * @param sem semaphore
+ * @returns E_OK if request was posted to kernel, E_BUSY if too many
+ * requests are pending.
+ */
+int isr_sem_give(sem_t * sem);
+
+/** Send message to message queue from ISR context.
+ * This routine is an equivalent of non-blocking \ref mqueue_send(),
+ * which is usable from interrupt service routine context. Message is
+ * copied immediately, it is queued once kernel gets to process the request.
+ * @param queue handle of message queue
+ * @param message message, size of message is given by queue
+ * @returns E_OK if message was posted to kernel, E_BUSY if queue is full or
+ * too many requests are pending, E_INVALID if handle is not valid.
+ */
+int isr_mqueue_send(int queue, const void * message);
 
 /** @} */
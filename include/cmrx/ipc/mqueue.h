@@ -0,0 +1,105 @@
+/** @defgroup api_mqueue Message queues
+ *
+ * @ingroup api
+ *
+ * Kernel-managed queues of fixed-size messages.
+ *
+ * Message queue decouples producers from consumers. Sender copies message
+ * into queue and continues without waiting for receiver to process it.
+ * Queues can be used between threads of different processes without any
+ * shared memory.
+ *
+ * All queues share a static pool of message slots, see @ref OS_MQUEUE_SLOTS
+ * and @ref OS_MQUEUE_SLOT_SIZE. Queue reserves as many slots as is its depth
+ * when it is created, so one queue can't starve others.
+ *
+ * Both send and receive can block, with or without timeout, or fail right
+ * away if queue is full or empty. If multiple threads block on the same
+ * queue, they are served in order of their priority. Interrupt service
+ * routines can send messages using @ref isr_mqueue_send().
+ *
+ * Message can be received without copying using @ref mqueue_receive_map().
+ * Slot holding the message is then mapped read-only into receiver's address
+ * space until receiver releases it.
+ */
+
+/** @ingroup api_mqueue
+ * @{
+ */
+#pragma once
+
+#include <stdint.h>
+#include <arch/sysenter.h>
+#include <cmrx/defines.h>
+
+/** Create new message queue.
+ * Queue is owned by the process of calling thread.
+ * @param depth how many messages queue can hold at once
+ * @param message_size size of each message in bytes, at most
+ * @ref OS_MQUEUE_SLOT_SIZE
+ * @returns handle of message queue if it was created. Negative value of
+ * E_OUT_OF_RANGE if all queues are in use or there are not enough free slots,
+ * E_INVALID if depth or message size are not valid.
+ */
+__SYSCALL int mqueue_create(unsigned depth, unsigned message_size);
+
+/** Delete message queue.
+ * Messages still queued are dropped. Threads blocked on the queue are woken
+ * up and their calls return E_INVALID. Messages mapped by receivers are
+ * unmapped, further access to them faults.
+ * @param queue handle of message queue
+ * @returns E_OK if queue was deleted, E_INVALID if handle is not valid or
+ * queue is owned by another process.
+ */
+__SYSCALL int mqueue_delete(int queue);
+
+/** Send message.
+ * Copies message into queue. If any thread waits for message, then message
+ * is handed over to the one with highest priority.
+ * @param queue handle of message queue
+ * @param message message, size of message is given by queue
+ * @param timeout_us maximal time to wait for free space in microseconds. 0
+ * means that call fails if queue is full, WAIT_FOREVER waits without timeout.
+ * @returns E_OK if message was sent, E_TIMEOUT if queue stayed full,
+ * E_INVALID if handle is not valid, E_INVALID_ADDRESS if calling thread
+ * can't read the message.
+ */
+__SYSCALL int mqueue_send(int queue, const void * message, unsigned timeout_us);
+
+/** Receive message.
+ * Copies oldest message out of queue.
+ * @param queue handle of message queue
+ * @param message buffer large enough to hold message
+ * @param timeout_us maximal time to wait for message in microseconds. 0
+ * means that call fails if queue is empty, WAIT_FOREVER waits without timeout.
+ * @returns E_OK if message was received, E_TIMEOUT if no message arrived,
+ * E_INVALID if handle is not valid, E_INVALID_ADDRESS if calling thread
+ * can't write the buffer.
+ */
+__SYSCALL int mqueue_receive(int queue, void * message, unsigned timeout_us);
+
+/** Receive message without copying it.
+ * Takes oldest message out of queue and maps its slot read-only into
+ * address space of calling thread. Thread can map only one message at a
+ * time. Message mapped previously is released. Slot counts against depth
+ * of the queue until it is released.
+ * @param queue handle of message queue
+ * @param message place to store address of message
+ * @param timeout_us maximal time to wait for message in microseconds. 0
+ * means that call fails if queue is empty, WAIT_FOREVER waits without timeout.
+ * @returns E_OK if message was received, E_TIMEOUT if no message arrived,
+ * E_INVALID if handle is not valid, E_INVALID_ADDRESS if calling thread
+ * can't write the address. Other error codes if memory protection can't map
+ * the message.
+ */
+__SYSCALL int mqueue_receive_map(int queue, const void ** message, unsigned timeout_us);
+
+/** Release message mapped by @ref mqueue_receive_map().
+ * Message is unmapped from address space of calling thread and its slot
+ * is returned to the queue.
+ * @returns E_OK if message was released, E_INVALID if thread has no
+ * message mapped.
+ */
+__SYSCALL int mqueue_release(void);
+
+/** @} */
@@ -14,24 +14,45 @@
 
 #include <stdint.h>
 #include <arch/sysenter.h>
+#include <cmrx/defines.h>
 
 #define MUTEX_INITIALIZED				1
 
+/** Futex uses immediate priority ceiling protocol */
+#define FUTEX_PRIORITY_CEILING			1
+
+/** Some threads may sleep in kernel waiting for futex to be unlocked */
+#define FUTEX_WAITERS					2
+
 /** Compile time initialization of futex.
  * If futex is initialized using this value, then it is not necessary
  * to call futex_init() during runtime.
  */
-#define FUTEX_STATIC_INIT		{ 0xFF, 0, 0 }
+#define FUTEX_STATIC_INIT		{ 0xFF, 0, 0, 0, 0 }
+
+/** Compile time initialization of futex having priority ceiling.
+ * See @ref futex_init_ceiling().
+ * @param priority ceiling priority of futex
+ */
+#define FUTEX_CEILING_INIT(priority)	{ 0xFF, FUTEX_PRIORITY_CEILING, 0, (priority), 0 }
 
 /** Futex structure.
  * This is fast userspace mutex, which avoids calling kernel.
  * It provides basic functionality for locking, unlocking and
  * non-blocking lock. It can be single-issue, or recursive.
+ *
+ * Owner, flags, state and ceiling form one 32-bit word. Contended lock
+ * sets FUTEX_WAITERS flag and sleeps in @ref futex_wait() on this word.
+ * Unlock only enters kernel if the flag is set.
  */
-typedef struct {
+typedef struct __attribute__((aligned(4))) {
 	uint8_t owner;
 	uint8_t flags;
 	uint8_t state;	
+	/** Ceiling priority, valid if FUTEX_PRIORITY_CEILING flag is set */
+	uint8_t ceiling;
+	/** Priority owner had before it locked the futex */
+	uint8_t saved_priority;
 } futex_t;
 
 /* Mutex structure.
@@ -50,11 +71,86 @@ typedef futex_t mutex_t;
  * memory region.
  */
 int futex_init(futex_t * restrict futex);
+
+/** Initialize futex having priority ceiling.
+ * Thread locking the futex is immediately raised to ceiling priority and
+ * runs at it until it unlocks the futex. Ceiling shall be the highest
+ * priority of all threads which use the futex. Thread holding the futex
+ * then can't be preempted by any other thread using it, which prevents
+ * priority inversion.
+ * @param futex futex to be initialized
+ * @param ceiling ceiling priority of futex
+ * @returns 0
+ */
+int futex_init_ceiling(futex_t * restrict futex, uint8_t ceiling);
 int futex_destroy(futex_t * futex);
 int futex_lock(futex_t * futex);
 int futex_unlock(futex_t * futex);
 int futex_trylock(futex_t * futex);
 
+/** Lock futex after being woken from waiting on it.
+ * Internal helper for primitives which move waiting threads onto futex
+ * using @ref futex_requeue(). Works as @ref futex_lock(), but assumes that
+ * more threads might be sleeping on the futex.
+ * @param futex futex to be locked
+ * @returns 0
+ */
+int __futex_lock_woken(futex_t * futex);
+
+/** Mark futex as having threads sleeping on it.
+ * Internal helper for primitives which move waiting threads onto futex
+ * using @ref futex_requeue(). Next unlock of futex will wake one of them.
+ * @param futex futex threads are moved to
+ */
+void __futex_set_waiters(futex_t * futex);
+
+/** Wait until futex word changes.
+ * If word at address contains expected value, then calling thread is blocked
+ * until someone calls @ref futex_wake() on the same address or timeout expires.
+ * Comparison and blocking is atomic with respect to @ref futex_wake().
+ * @param address address of 32-bit futex word
+ * @param expected value word is expected to contain
+ * @param timeout_us maximal time to wait in microseconds, WAIT_FOREVER to wait without timeout
+ * @returns E_OK if thread was woken up. E_BUSY if word didn't contain expected value.
+ * E_TIMEOUT if wait timed out. E_MISALIGNED if address is not aligned.
+ * E_INVALID_ADDRESS if calling thread can't access the futex word.
+ */
+__SYSCALL int futex_wait(uint32_t * address, uint32_t expected, unsigned timeout_us);
+
+/** Wake threads waiting for futex word.
+ * Threads are woken in order of their priority.
+ * @param address address of 32-bit futex word
+ * @param count maximal amount of threads woken up
+ * @returns amount of threads woken up
+ */
+__SYSCALL int futex_wake(uint32_t * address, unsigned count);
+
+/** Wake threads waiting for futex word and move the rest to another word.
+ * Up to count threads waiting for address are woken up. All other threads
+ * waiting for address are moved to wait for target instead. They are
+ * then woken by @ref futex_wake() on target. Their timeouts stay armed.
+ * @param address address of 32-bit futex word
+ * @param count maximal amount of threads woken up
+ * @param target address of 32-bit futex word threads are moved to
+ * @returns amount of threads woken up or moved. 0 if target is not aligned.
+ */
+__SYSCALL int futex_requeue(uint32_t * address, unsigned count, uint32_t * target);
+
+/** Futex got acquired by calling thread */
+#define LOCK_PROFILE_ACQUIRED	0
+
+/** Futex is going to be released by calling thread */
+#define LOCK_PROFILE_RELEASED	1
+
+/** Report lock event to lock profiler.
+ * Internal helper called by futex lock and unlock if kernel is built with
+ * KERNEL_HAS_LOCK_PROFILE. See @ref os_lock_profile_event().
+ * @param lock address of lock
+ * @param event LOCK_PROFILE_ACQUIRED or LOCK_PROFILE_RELEASED
+ * @returns E_OK, E_INVALID if event is not known
+ */
+__SYSCALL int lock_profile(const void * lock, unsigned event);
+
 /** Mutexes
  * Mutexes are fully features inter-process locking primitive.
  * They are implemented as kernel system calls, so they are 
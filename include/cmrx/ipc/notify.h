@@ -0,0 +1,46 @@
+/** @defgroup api_notify Thread notifications
+ *
+ * @ingroup api
+ *
+ * API for lightweight direct-to-thread notifications.
+ *
+ * Each thread owns small array of notification counters. Any thread can
+ * give notification to another thread, which increments the counter.
+ * Interrupt service routines can use @ref isr_notify_give(). The owner
+ * takes notifications, possibly blocking until some are given. Unlike
+ * signals, notifications given repeatedly are counted and not merged.
+ * No object has to be allocated.
+ */
+
+/** @ingroup api_notify
+ * @{
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <arch/sysenter.h>
+#include <cmrx/defines.h>
+
+/** Give notification to thread.
+ * Increments notification counter of thread. If thread waits for it, then
+ * it is woken up.
+ * @param thread thread receiving the notification
+ * @param index index of notification counter
+ * @returns E_OK if notification was given, E_INVALID if thread doesn't exist
+ * or index is out of range.
+ */
+__SYSCALL int notify_give(Thread_t thread, unsigned index);
+
+/** Take notifications given to calling thread.
+ * Blocks calling thread until its notification counter is non-zero.
+ * @param index index of notification counter
+ * @param clear if true, counter is cleared. Otherwise it is decremented by one.
+ * @param timeout_us maximal time to wait in microseconds. 0 means that only
+ * counter is examined, WAIT_FOREVER waits without timeout.
+ * @returns value of counter before it was taken. 0 if wait timed out.
+ * Negative value of E_INVALID if index is out of range.
+ */
+__SYSCALL int notify_take(unsigned index, bool clear, unsigned timeout_us);
+
+/** @} */
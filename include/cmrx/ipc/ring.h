@@ -0,0 +1,140 @@
+/** @defgroup api_ring Ring buffers
+ *
+ * @ingroup api
+ *
+ * Lock-free ring buffers for streaming data between threads.
+ *
+ * Ring buffer transfers fixed-size items from producers to one consumer
+ * without entering the kernel for each item. Ring lives in memory reachable
+ * by all its users. Memory placed into @ref SHARED section is only reachable
+ * by the owning process and by servers of RPC calls it is making, so it is
+ * not suitable for rings between independent processes. If producer and
+ * consumer live in different processes, place the ring and its storage into
+ * shared memory window, see @ref shmem_window_open().
+ *
+ * Two variants are provided, which differ in producer side only:
+ * * single producer, single consumer - @ref ring_push() is wait-free
+ * * multiple producers, single consumer - @ref ring_push_multi() reserves
+ *   space atomically. Producer publishes its items once all producers which
+ *   reserved space before it did so.
+ *
+ * Items are pushed and popped in batches. Indices written by producers and
+ * by consumer are placed into separate cache lines.
+ *
+ * Consumer is only woken up when ring goes from empty to non-empty. By
+ * default consumer sleeps in @ref ring_pop_wait() on the futex word formed
+ * by producer index. Alternatively, producer can send a signal to consumer
+ * thread, see @ref ring_set_signal().
+ */
+
+/** @ingroup api_ring
+ * @{
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <cmrx/defines.h>
+
+#ifndef RING_CACHE_LINE
+/** Size of cache line indices are padded to */
+#	define RING_CACHE_LINE		32
+#endif
+
+/** Consumer is not woken by signal */
+#define RING_NO_SIGNAL			0xFF
+
+/** Ring buffer.
+ * Indices are free running, position in storage is index modulo capacity.
+ */
+typedef struct __attribute__((aligned(RING_CACHE_LINE))) {
+	/** Index one past last published item. Written by producers. */
+	volatile uint32_t head;
+	/** Index one past last reserved item. Written by producers. */
+	volatile uint32_t reserve;
+	/** Index of oldest item not consumed yet. Written by consumer. */
+	volatile uint32_t tail __attribute__((aligned(RING_CACHE_LINE)));
+	/** Storage of items */
+	uint8_t * buffer __attribute__((aligned(RING_CACHE_LINE)));
+	/** Size of one item in bytes */
+	uint16_t item_size;
+	/** Thread woken by signal, if signal is set */
+	uint8_t consumer;
+	/** Signal sent to consumer, RING_NO_SIGNAL to use futex wake */
+	uint8_t signal;
+	/** Amount of items ring can hold, power of two */
+	uint32_t capacity;
+} ring_t;
+
+/** Compile time initialization of ring buffer.
+ * @param storage array of capacity items
+ * @param size size of one item
+ * @param items amount of items storage can hold, power of two
+ */
+#define RING_STATIC_INIT(storage, size, items) \
+	{ .head = 0, .reserve = 0, .tail = 0, .buffer = (uint8_t *) (storage), \
+	  .item_size = (size), .consumer = 0, .signal = RING_NO_SIGNAL, .capacity = (items) }
+
+/** Initialize ring buffer.
+ * @param ring ring buffer
+ * @param storage storage of capacity items
+ * @param item_size size of one item in bytes
+ * @param capacity amount of items storage can hold, power of two
+ * @returns E_OK, E_INVALID if capacity is not power of two
+ */
+int ring_init(ring_t * ring, void * storage, unsigned item_size, unsigned capacity);
+
+/** Wake consumer by signal instead of futex.
+ * Producer which makes ring non-empty sends signal to consumer thread.
+ * Consumer can either handle the signal or wait for it in
+ * @ref ring_pop_wait().
+ * @param ring ring buffer
+ * @param consumer consumer thread
+ * @param signal catchable signal, RING_NO_SIGNAL to go back to futex wake
+ * @returns E_OK, E_INVALID if signal is not catchable
+ */
+int ring_set_signal(ring_t * ring, Thread_t consumer, unsigned signal);
+
+/** Push items, single producer variant.
+ * Must not be used if multiple threads push into the same ring.
+ * @param ring ring buffer
+ * @param items items to be pushed
+ * @param count amount of items
+ * @returns amount of items pushed, less than count if ring got full
+ */
+unsigned ring_push(ring_t * ring, const void * items, unsigned count);
+
+/** Push items, multiple producers variant.
+ * @param ring ring buffer
+ * @param items items to be pushed
+ * @param count amount of items
+ * @returns amount of items pushed, less than count if ring got full
+ */
+unsigned ring_push_multi(ring_t * ring, const void * items, unsigned count);
+
+/** Pop items.
+ * Only one thread can pop items from ring.
+ * @param ring ring buffer
+ * @param items buffer for popped items
+ * @param count maximal amount of items popped
+ * @returns amount of items popped, 0 if ring is empty
+ */
+unsigned ring_pop(ring_t * ring, void * items, unsigned count);
+
+/** Pop items, waiting until there are some.
+ * @param ring ring buffer
+ * @param items buffer for popped items
+ * @param count maximal amount of items popped
+ * @param timeout_us maximal time to wait for items in microseconds,
+ * WAIT_FOREVER waits without timeout
+ * @returns amount of items popped, 0 if wait timed out
+ */
+unsigned ring_pop_wait(ring_t * ring, void * items, unsigned count, unsigned timeout_us);
+
+/** Get amount of items in ring.
+ * @param ring ring buffer
+ * @returns amount of published items not popped yet
+ */
+unsigned ring_count(const ring_t * ring);
+
+/** @} */
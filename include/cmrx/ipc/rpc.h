@@ -7,6 +7,7 @@
 #pragma once
 
 #include <arch/sysenter.h>
+#include <cmrx/defines.h>
 #include <stddef.h>
 
 // Return 1 if type of x is pointer-to-something, 0 otherwise
@@ -35,6 +36,19 @@
 #define CMRX_RPC_CALL_1(si, mi, _0)				_rpc_call((unsigned) _0, 0, 0, 0, (void *) si, mi, 0xAA55AA55)
 #define CMRX_RPC_CALL_0(si, mi)					_rpc_call(0, 0, 0, 0, si, mi, 0xAA55AA55)
 
+/*
+ * Same as above, but for other flavors of RPC call. Name of the syscall
+ * wrapper and value of its last argument are passed as parameters.
+ */
+
+#define CMRX_RPC_INVOKE_PASTER(argcount)	                        CMRX_RPC_INVOKE_ ## argcount
+#define CMRX_RPC_INVOKE_EVALUATOR(argcount)	                    CMRX_RPC_INVOKE_PASTER(argcount)
+#define CMRX_RPC_INVOKE_4(fn, ex, si, mi, _0, _1, _2, _3)	fn((unsigned) _0, (unsigned) _1, (unsigned) _2, (unsigned) _3, si, mi, ex)
+#define CMRX_RPC_INVOKE_3(fn, ex, si, mi, _0, _1, _2)		fn((unsigned) _0, (unsigned) _1, (unsigned) _2, 0, si, mi, ex)
+#define CMRX_RPC_INVOKE_2(fn, ex, si, mi, _0, _1)			fn((unsigned) _0, (unsigned) _1, 0, 0, si, mi, ex)
+#define CMRX_RPC_INVOKE_1(fn, ex, si, mi, _0)				fn((unsigned) _0, 0, 0, 0, (void *) si, mi, ex)
+#define CMRX_RPC_INVOKE_0(fn, ex, si, mi)					fn(0, 0, 0, 0, si, mi, ex)
+
 /*
  * Perform compile time type checking of the RPC call arguments.
  * This will emit code which apparently calls the rpc method directly. This call
@@ -90,6 +104,25 @@
 			offsetof(typeof(*((service_instance)->vtable)), method_name) / sizeof(void *), \
 			##__VA_ARGS__);
 
+/*
+ * Generic variant of the master RPC call macro.
+ * Performs the same compile time checks as CMRX_RPC_CALL, then passes
+ * the call to given syscall wrapper and evaluates to its return value.
+ */
+
+#define CMRX_RPC_INVOKE(function, extra, service_instance, method_name, ...)\
+	({ \
+    CMRX_RPC_SERVICE_FORM_CHECKER(service_instance); \
+	CMRX_RPC_TYPE_CHECKER(CMRX_RPC_GET_ARG_COUNT(__VA_ARGS__), (service_instance)->vtable->method_name, __VA_ARGS__) \
+    CMRX_RPC_INTERFACE_CHECKER(service_instance); \
+	CMRX_RPC_INVOKE_EVALUATOR(CMRX_RPC_GET_ARG_COUNT(__VA_ARGS__))(\
+			function, \
+			(extra), \
+			(service_instance), \
+			offsetof(typeof(*((service_instance)->vtable)), method_name) / sizeof(void *), \
+			##__VA_ARGS__); \
+	})
+
 /**
  * @ingroup api_rpc
  * @{
@@ -131,4 +164,165 @@ __SYSCALL int _rpc_call(unsigned arg0, unsigned arg1, unsigned arg2, unsigned ar
  */
 __SYSCALL void rpc_return();
 
+/** User-visible way to perform remote procedure call with deadline.
+ *
+ * Works the same way as @ref rpc_call() does, including all the compile time
+ * checks. If the method does not return within given time, the call is aborted
+ * and the caller continues as if the method returned E_TIMEOUT. Anything method
+ * did until then is not reverted. Process owning the service can learn that call
+ * into it was aborted using @ref rpc_cancel_notify().
+ *
+ * Only one call with deadline can be active per thread. Nested call with deadline
+ * fails with E_BUSY.
+ * @param timeout_us deadline of the call in microseconds
+ * @param service_instance address of service instance, which is being called
+ * @param method_name name of method within service, which has to be called
+ * @returns whatever value service returned or E_TIMEOUT if deadline expired
+ */
+#define rpc_call_timed(timeout_us, service_instance, method_name, ...) CMRX_RPC_INVOKE(_rpc_call_timed, timeout_us, service_instance, method_name __VA_OPT__(,) __VA_ARGS__)
+
+/** Internal implementation of remote procedure call with deadline in userspace.
+ *
+ * This function is actually called when user calls @ref rpc_call_timed().
+ * @param service address of service instance
+ * @param method offset of method in VMT of service
+ * @param timeout deadline of the call in microseconds
+ * @return whatever service method returns or E_TIMEOUT
+ */
+int _rpc_call_timed(unsigned arg0, unsigned arg1, unsigned arg2, unsigned arg3, void * service, unsigned method, unsigned timeout);
+
+/** Register for notification about aborted RPC calls.
+ *
+ * If RPC call into any service owned by calling process is aborted due to
+ * its deadline expiring, then given thread receives given signal. Process
+ * may use this to reset state of service which was interrupted in the middle
+ * of the call.
+ * @param thread_id thread which will receive the signal
+ * @param signal signal number. Use @ref RPC_NO_SIGNAL to cancel the registration.
+ * @returns E_OK, E_INVALID if thread does not exist
+ */
+__SYSCALL int rpc_cancel_notify(Thread_t thread_id, uint32_t signal);
+
+/** User-visible way to perform asynchronous remote procedure call.
+ *
+ * Works the same way as @ref rpc_call() does, including all the compile time
+ * checks, but the calling thread does not execute the method. Instead, the call
+ * is queued and executed by server thread of process owning the service. Calling
+ * thread continues immediately.
+ *
+ * Once the method finishes, calling thread receives the signal given. Return value of
+ * the method can be collected using @ref rpc_poll().
+ * @param signal signal delivered to calling thread once method finished. Use
+ * @ref RPC_NO_SIGNAL if no signal shall be delivered.
+ * @param service_instance address of service instance, which is being called
+ * @param method_name name of method within service, which has to be called
+ * @returns non-negative completion token, which identifies the call. Negative
+ * value is returned if call could not be queued: -E_BUSY if there are too many
+ * pending requests, -E_INVALID_ADDRESS if service is not known.
+ */
+#define rpc_call_async(signal, service_instance, method_name, ...) CMRX_RPC_INVOKE(_rpc_call_async, signal, service_instance, method_name __VA_OPT__(,) __VA_ARGS__)
+
+/** Internal implementation of asynchronous remote procedure call in userspace.
+ *
+ * This function is actually called when user calls @ref rpc_call_async().
+ * @param service address of service instance
+ * @param method offset of method in VMT of service
+ * @param signal signal delivered once method finishes
+ * @returns completion token or negative error code
+ */
+__SYSCALL int _rpc_call_async(unsigned arg0, unsigned arg1, unsigned arg2, unsigned arg3, void * service, unsigned method, unsigned signal);
+
+/** User-visible way to send one-way notification using remote procedure call.
+ *
+ * Works the same way as @ref rpc_call_async() does, but the caller never learns
+ * the result of the call. Return value of the method is thrown away once it
+ * finishes. If the very same notification (same service, method and arguments) is
+ * already waiting for execution, then no new request is queued. Calling thread
+ * never blocks.
+ *
+ * Notifications are executed by server threads of process owning the service,
+ * see @ref rpc_serve() and @ref OS_RPC_WORKER().
+ * @param service_instance address of service instance, which is being notified
+ * @param method_name name of method within service, which has to be called
+ * @returns E_OK if notification was queued or merged with pending one. Negative
+ * value is returned if notification could not be queued, see @ref rpc_call_async().
+ */
+#define rpc_notify(service_instance, method_name, ...) CMRX_RPC_INVOKE(_rpc_call_async, RPC_NOTIFY_FLAG | RPC_NO_SIGNAL, service_instance, method_name __VA_OPT__(,) __VA_ARGS__)
+
+/** User-visible way to perform remote procedure call executed by worker thread.
+ *
+ * Works the same way as @ref rpc_call() does, including all the compile time
+ * checks, but the calling thread does not migrate into the service process.
+ * Instead, the call is copied into the queue of process owning the service and
+ * executed by one of its worker threads (see @ref OS_RPC_WORKER()) at their
+ * priority and on their stack. Calling thread is blocked until the method returns.
+ * @param service_instance address of service instance, which is being called
+ * @param method_name name of method within service, which has to be called
+ * @returns whatever value service returned. If call could not be queued, then
+ * -E_BUSY is returned if queue of service process is full and -E_INVALID_ADDRESS
+ * is returned if service is not known.
+ */
+#define rpc_call_queued(service_instance, method_name, ...) CMRX_RPC_INVOKE(_rpc_call_queued, 0xAA55AA55, service_instance, method_name __VA_OPT__(,) __VA_ARGS__)
+
+/** Internal implementation of queued remote procedure call in userspace.
+ *
+ * This function is actually called when user calls @ref rpc_call_queued().
+ * @param service address of service instance
+ * @param method offset of method in VMT of service
+ * @return whatever service method returns
+ */
+__SYSCALL int _rpc_call_queued(unsigned arg0, unsigned arg1, unsigned arg2, unsigned arg3, void * service, unsigned method, unsigned canary);
+
+/** Execute asynchronous RPC requests.
+ *
+ * Thread calling this function becomes server thread of its process. If there is any
+ * asynchronous request queued for any service owned by this process, then the method
+ * is executed by this thread. Otherwise the thread is blocked until some request arrives.
+ * Typical server thread calls this function in an endless loop.
+ * @returns E_OK once one request was executed
+ */
+__SYSCALL int rpc_serve();
+
+/** Entrypoint of RPC worker thread.
+ *
+ * Serves requests queued for process the worker belongs to forever. Worker
+ * threads are usually created using @ref OS_RPC_WORKER().
+ * @param data unused
+ * @returns never returns
+ */
+int rpc_worker(void * data);
+
+/** Collect result of asynchronous remote procedure call.
+ *
+ * Checks if asynchronous call identified by token has finished. If so, the return value
+ * of method is stored and the token is released. Token can't be used anymore afterwards.
+ * Only thread which performed the call can collect its result.
+ * @param token completion token returned by @ref rpc_call_async()
+ * @param [out] retval address where the return value of method will be stored
+ * @returns E_OK if the call has finished, E_BUSY if the call is still queued or running,
+ * E_INVALID if token is not valid.
+ */
+int rpc_poll(int token, int * retval);
+
+/** Check if asynchronous call has finished. Used by @ref rpc_poll().
+ * @param token completion token
+ * @returns E_OK if the call has finished, E_BUSY if it is still queued or
+ * running, E_INVALID if token is not valid.
+ */
+__SYSCALL int _rpc_poll(int token);
+
+/** Collect return value of finished asynchronous call and release its token.
+ * Used by @ref rpc_poll().
+ * @param token completion token for which @ref _rpc_poll() returned E_OK
+ * @returns return value of the method
+ */
+__SYSCALL int _rpc_result(int token);
+
+/** The way how asynchronous RPC returns. Used automatically.
+ *
+ * Kernel uses this to return from method executed by server thread. No need to call it
+ * manually.
+ */
+__SYSCALL void rpc_async_return();
+
 /** @} */
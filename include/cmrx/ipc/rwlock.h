@@ -0,0 +1,84 @@
+/** @defgroup api_rwlock Reader-writer locks
+ *
+ * @ingroup api
+ *
+ * Locks allowing either many readers or one writer at a time.
+ *
+ * Readers take the lock by single atomic operation unless a writer holds
+ * the lock or waits for it. Writers are preferred: once a writer waits
+ * for the lock, new readers wait until it has finished. Contended paths
+ * sleep in kernel using @ref futex_wait().
+ *
+ * Lock only consists of plain words. It can be shared between processes
+ * by placing it into shared memory.
+ */
+
+/** @ingroup api_rwlock
+ * @{
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Compile time initialization of reader-writer lock.
+ * If lock is initialized using this value, then it is not necessary
+ * to call rwlock_init() during runtime.
+ */
+#define RWLOCK_STATIC_INIT		{ 0, 0 }
+
+/** Reader-writer lock structure */
+typedef struct {
+	/** Amount of readers holding the lock, writer flag and amount of writers waiting */
+	uint32_t state;
+	/** Sequence number writers sleep on */
+	uint32_t writer_sequence;
+} rwlock_t;
+
+/** Initialize reader-writer lock.
+ * @param lock lock to be initialized
+ * @returns 0
+ */
+int rwlock_init(rwlock_t * lock);
+
+/** Lock for reading.
+ * Blocks until no writer holds or waits for the lock.
+ * @param lock lock
+ * @returns 0 if lock was taken, error code returned by @ref futex_wait() if
+ * thread can't sleep on the lock
+ */
+int rwlock_read_lock(rwlock_t * lock);
+
+/** Try to lock for reading without blocking.
+ * @param lock lock
+ * @returns 0 if lock was taken, E_BUSY if writer holds or waits for the lock
+ */
+int rwlock_read_trylock(rwlock_t * lock);
+
+/** Release lock taken for reading.
+ * @param lock lock
+ * @returns 0
+ */
+int rwlock_read_unlock(rwlock_t * lock);
+
+/** Lock for writing.
+ * Blocks until nobody holds the lock. New readers are held off meanwhile.
+ * @param lock lock
+ * @returns 0 if lock was taken, error code returned by @ref futex_wait() if
+ * thread can't sleep on the lock
+ */
+int rwlock_write_lock(rwlock_t * lock);
+
+/** Try to lock for writing without blocking.
+ * @param lock lock
+ * @returns 0 if lock was taken, E_BUSY if anyone holds the lock
+ */
+int rwlock_write_trylock(rwlock_t * lock);
+
+/** Release lock taken for writing.
+ * @param lock lock
+ * @returns 0
+ */
+int rwlock_write_unlock(rwlock_t * lock);
+
+/** @} */
@@ -0,0 +1,65 @@
+/** @defgroup api_sem Counting semaphores
+ *
+ * @ingroup api
+ *
+ * Semaphores count available units of some resource.
+ *
+ * Thread takes one unit, blocking while there is none available. Taking
+ * and giving don't enter kernel unless some thread has to sleep or be
+ * woken up. Threads sleeping on semaphore are woken in order of their
+ * priority. Interrupt service routines can give units using
+ * @ref isr_sem_give().
+ *
+ * Semaphore only consists of plain word. It can be shared between processes
+ * by placing it into shared memory.
+ */
+
+/** @ingroup api_sem
+ * @{
+ */
+#pragma once
+
+#include <stdint.h>
+
+/** Some threads may sleep waiting for semaphore */
+#define SEM_WAITERS				0x80000000
+
+/** Mask of semaphore count */
+#define SEM_COUNT				0x7FFFFFFF
+
+/** Compile time initialization of semaphore.
+ * @param count initial amount of units available
+ */
+#define SEM_STATIC_INIT(count)	{ (count) }
+
+/** Semaphore structure */
+typedef struct {
+	/** Amount of units available and waiters flag */
+	uint32_t value;
+} sem_t;
+
+/** Initialize semaphore.
+ * @param sem semaphore
+ * @param count initial amount of units available
+ * @returns 0
+ */
+int sem_init(sem_t * sem, uint32_t count);
+
+/** Take one unit from semaphore.
+ * Blocks calling thread until unit is available.
+ * @param sem semaphore
+ * @param timeout_us maximal time to wait in microseconds. 0 means that
+ * call doesn't block, WAIT_FOREVER waits without timeout.
+ * @returns E_OK if unit was taken, E_TIMEOUT if none became available in time,
+ * error code returned by @ref futex_wait() if thread can't sleep on semaphore
+ */
+int sem_take(sem_t * sem, unsigned timeout_us);
+
+/** Give one unit to semaphore.
+ * If any thread waits for semaphore, the one with highest priority is woken up.
+ * @param sem semaphore
+ * @returns E_OK
+ */
+int sem_give(sem_t * sem);
+
+/** @} */
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <arch/sysenter.h>
+#include <cmrx/defines.h>
+
 /** @defgroup api_shared Shared memory
  *
  * @ingroup api
@@ -12,6 +15,13 @@
  * the caller's memory. This is to ensure robustness. If client has a need 
  * to communicate larger chunk of data with RPC server, then the buffer holding this 
  * data must be marked as belonging to the shared memory.
+ *
+ * Processes which exchange larger amounts of data continuously can establish
+ * shared memory window instead. Window is a block of memory owned by one
+ * process, which is made accessible to one other process for as long as the
+ * window exists. Data is then exchanged without any kernel involvement. Each
+ * process can take part in at most one window and processes which use second
+ * memory-mapped IO range can't take part in any.
  */
 
 /** @ingroup api_shared
@@ -27,4 +37,47 @@
  */
 #define SHARED __attribute__((section(".shared")))
 
+/** Peer process can write into window, otherwise it can only read it */
+#define SHMEM_PEER_WRITE		1
+
+/** Owner process can only read window, otherwise it can read and write it */
+#define SHMEM_OWNER_READ_ONLY	2
+
+/** Reference process by name of its application.
+ * @param application name of application given to @ref OS_APPLICATION()
+ * @returns reference to process usable as peer of shared memory window
+ */
+#define SHMEM_PROCESS(application) ({\
+	extern const struct OS_process_definition_t application ## _instance;\
+	&application ## _instance;\
+})
+
+struct OS_process_definition_t;
+
+/** Open shared memory window to another process.
+ * Window is owned by the process of calling thread and has to lie within
+ * memory of this process. Window becomes accessible to the peer process
+ * immediately, including its RPC services.
+ * @param peer process window is shared with, see @ref SHMEM_PROCESS()
+ * @param base base address of window, aligned to size of window
+ * @param size size of window, power of two, at least 32 bytes (256 bytes on
+ * ARMv6-M)
+ * @param flags access rights of both sides, see @ref SHMEM_PEER_WRITE and
+ * @ref SHMEM_OWNER_READ_ONLY
+ * @returns handle of window if it was opened. Negative value of E_INVALID if
+ * peer is not valid, E_MISALIGNED if size or base are not valid,
+ * E_INVALID_ADDRESS if memory is not owned by caller, E_BUSY if either process
+ * can't take part in another window, E_OUT_OF_RANGE if all windows are in use.
+ */
+__SYSCALL int shmem_window_open(const struct OS_process_definition_t * peer, void * base, unsigned size, unsigned flags);
+
+/** Close shared memory window.
+ * Window is removed from address spaces of both processes. Either of them
+ * can close the window.
+ * @param window handle of window
+ * @returns E_OK if window was closed, E_INVALID if handle is not valid or
+ * caller does not take part in window.
+ */
+__SYSCALL int shmem_window_close(int window);
+
 /** @} */
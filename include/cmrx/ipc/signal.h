@@ -15,9 +15,15 @@
  * able to catch nor react to them. These include stopping and resuming thread,
  * killing it and signalling memory protection violation error.
  *
- * If thread doesn't register any signal handler, then signal arrival is effectively
- * a no-op for given thread. In any case, arrival of signal will wake thread up,
- * if it is stopped.
+ * Each catchable signal has its own handler. If thread doesn't register handler
+ * for the signal, then signal stays pending and its arrival is effectively a no-op
+ * for given thread. In any case, arrival of signal will wake thread up, if it is
+ * stopped. If multiple signals are pending at once, their handlers are called
+ * in order of signal numbers, lowest first.
+ *
+ * Catchable signals sent using @ref kill() are pending as a bitmask, so repeated
+ * signals collapse into one. Signals sent using @ref sigqueue() are queued
+ * individually and carry 32-bit value which is passed to the signal handler.
  */
 
 /** @ingroup api_signal
@@ -27,6 +33,7 @@
 
 #include <stdint.h>
 #include <arch/sysenter.h>
+#include <cmrx/defines.h>
 
 #define SIGALRM					0
 
@@ -35,12 +42,14 @@
 #define SIGCONT					34
 #define SIGSEGV					35
 
-/** Register function as current thread signal handler.
- * @param signo number of signal
- * @param sighandler address of function which handles the signal
- * @returns 0. Mostly.
+/** Register function as current thread handler of signal.
+ * Signal handler receives number of signal being delivered and value. Value
+ * is the one passed to @ref sigqueue(), or 0 for signals sent by @ref kill().
+ * @param signo number of catchable signal
+ * @param sighandler address of function which handles the signal, NULL to stop handling it
+ * @returns 0 if handler was registered, E_INVALID if signal number is not catchable.
  */
-__SYSCALL int signal(int signo, void (*sighandler)(uint32_t));
+__SYSCALL int signal(int signo, void (*sighandler)(uint32_t signo, uint32_t value));
 
 /** Send thread a signal.
  *
@@ -51,4 +60,29 @@ __SYSCALL int signal(int signo, void (*sighandler)(uint32_t));
  */
 __SYSCALL int kill(int thread, uint32_t signal);
 
+/** Send thread a signal carrying value.
+ *
+ * Queue signal for the thread. Unlike @ref kill(), repeated signals don't
+ * collapse, each is delivered separately in order in which they were queued.
+ * Non-catchable signals are handled the same way as by @ref kill().
+ * @param thread recipient thread id
+ * @param signal signal number
+ * @param value value passed to signal handler
+ * @returns 0 if signal was queued. E_BUSY if signal queue of thread is full.
+ * E_INVALID if thread can't receive signals.
+ */
+__SYSCALL int sigqueue(int thread, uint32_t signal, uint32_t value);
+
+/** Wait for signals synchronously.
+ *
+ * Blocks calling thread until any of signals in mask becomes pending. Signals
+ * received are cleared and returned to the caller. Their handlers are not
+ * called. Values carried by queued signals are dropped.
+ * @param mask mask of catchable signals thread waits for
+ * @param timeout_us maximal time to wait in microseconds. 0 means that only
+ * signals already pending are collected, WAIT_FOREVER waits without timeout.
+ * @returns mask of signals received, cast to uint32_t. 0 if wait timed out.
+ */
+__SYSCALL int sigwait(uint32_t mask, unsigned timeout_us);
+
 /** @} */
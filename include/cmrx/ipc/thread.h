@@ -85,5 +85,17 @@ __SYSCALL int thread_exit(int status);
 
 __SYSCALL int setpriority(uint8_t priority);
 
+/** Raise thread priority to ceiling.
+ *
+ * If calling thread has lower priority than the ceiling, then its priority is
+ * raised to the ceiling. Otherwise priority is not changed. Previous priority
+ * can be restored using @ref setpriority(). This is cheaper than
+ * @ref setpriority() as raising priority of running thread never causes
+ * thread switch.
+ * @param ceiling priority thread shall run at least at
+ * @returns priority thread had before this call
+ */
+__SYSCALL int priority_ceiling(uint8_t ceiling);
+
 /** @} */
 
@@ -0,0 +1,107 @@
+/** @defgroup api_wait Waiting for multiple objects
+ *
+ * @ingroup api
+ *
+ * API for waiting for any of several event sources at once.
+ *
+ * Thread describes each source it is interested in using one @ref WaitObject
+ * entry and passes array of them to @ref wait_objects(). Thread is blocked
+ * until any of sources becomes ready. Following sources are supported:
+ *
+ * * futex - ready if word doesn't contain expected value or if @ref futex_wake()
+ *   is called on it
+ * * signals - ready if any of signals in mask is pending
+ * * event group - ready if event group satisfies wait condition
+ * * notification - ready if notification counter of calling thread is non-zero
+ *
+ * Timer expiry is waited for as signal SIGALRM. Readability of ComSource is
+ * waited for by letting its notification handler wake futex or send signal.
+ */
+
+/** @ingroup api_wait
+ * @{
+ */
+#pragma once
+
+#include <stdint.h>
+#include <arch/sysenter.h>
+#include <cmrx/defines.h>
+
+/** Kinds of sources thread can wait for */
+enum WaitObjectType {
+	/** Wait for futex word, see @ref futex_wait() */
+	WAIT_FUTEX,
+	/** Wait for signals to become pending */
+	WAIT_SIGNAL,
+	/** Wait for event group flags, see @ref event_group_wait() */
+	WAIT_EVENT_GROUP,
+	/** Wait for notification counter, see @ref notify_take() */
+	WAIT_NOTIFICATION
+};
+
+/** Description of one source thread waits for */
+struct WaitObject {
+	/** Kind of source, see @ref WaitObjectType */
+	uint8_t type;
+	/** Event group wait flags. Unused by other sources. */
+	uint8_t flags;
+	/** Address of futex word, event group handle or notification counter index.
+	 * Unused by signals.
+	 */
+	uintptr_t object;
+	/** Expected futex value, mask of signals or mask of event group flags */
+	uint32_t value;
+};
+
+/** Describe futex word as source to wait for.
+ * @param address address of futex word
+ * @param expected value word is expected to hold
+ */
+#define WAIT_ON_FUTEX(address, expected) \
+	{ WAIT_FUTEX, 0, (uintptr_t) (address), (expected) }
+
+/** Describe signals as source to wait for.
+ * @param mask mask of catchable signals
+ */
+#define WAIT_ON_SIGNALS(mask) \
+	{ WAIT_SIGNAL, 0, 0, (mask) }
+
+/** Describe event group as source to wait for.
+ * @param group event group handle
+ * @param bits mask of flags
+ * @param flags EVENT_WAIT_ANY or EVENT_WAIT_ALL, optionally combined with EVENT_WAIT_CLEAR
+ */
+#define WAIT_ON_EVENT_GROUP(group, bits, flags) \
+	{ WAIT_EVENT_GROUP, (flags), (uintptr_t) (group), (bits) }
+
+/** Describe notification counter of calling thread as source to wait for.
+ * @param index index of notification counter
+ */
+#define WAIT_ON_NOTIFICATION(index) \
+	{ WAIT_NOTIFICATION, 0, (index), 0 }
+
+/** Wait until any of sources becomes ready.
+ *
+ * Sources are examined in order in which they are listed. If any of them
+ * is ready already, then call returns immediately. Otherwise calling thread
+ * waits for all of them at once and is woken up by the first one becoming
+ * ready.
+ *
+ * Signals are not taken by this call. If thread has handler for the signal,
+ * then it is called before this call returns. Otherwise signal stays pending
+ * and can be collected using @ref sigwait(). Event group flags are cleared
+ * if EVENT_WAIT_CLEAR was requested. Notification counters are not taken,
+ * use @ref notify_take() to collect them.
+ * @param objects array of source descriptions
+ * @param count amount of entries in array, at most OS_WAIT_OBJECTS
+ * @param timeout_us maximal time to wait in microseconds. 0 means that sources
+ * are only examined, WAIT_FOREVER waits without timeout.
+ * @returns index of source which is ready. Negative value of E_TIMEOUT if
+ * wait timed out. Negative value of E_DELETED if event group waited for was
+ * deleted. Negative value of E_INVALID if any description is not
+ * valid, E_MISALIGNED if futex word is not aligned, E_INVALID_ADDRESS if
+ * calling thread can't access the array or any futex word.
+ */
+__SYSCALL int wait_objects(const struct WaitObject * objects, unsigned count, unsigned timeout_us);
+
+/** @} */
@@ -5,7 +5,9 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <arch/mpu.h>
+#include <cmrx/os/mpu.h>
 
 /** Forward declaration of structure that holds state of MPU
  * The implementor of a port shall provide definition of this 
@@ -40,5 +42,52 @@ int mpu_init_stack(int thread_id);
  */
 int mpu_restore(const MPU_State * hosted_state, const MPU_State * parent_state);
 
+/** Load memory window of thread.
+ * Configures MPU so that running thread can access its memory window.
+ * If no window is mapped, then window region is disabled.
+ * @param window memory window of thread
+ * @returns E_OK if window was loaded, error code if MPU can't map it
+ */
+int mpu_load_window(const struct OS_MPU_window_t * window);
+
+/** Load view of buffer pool into MPU.
+ * Configures MPU so that running thread can access buffers owned by its
+ * process. View occupies its own region, so it coexists with thread window.
+ * @param view view of buffer pool of process
+ * @returns E_OK if view was loaded, error code if MPU can't map it
+ */
+int mpu_load_buffer_view(const struct OS_MPU_window_t * view);
+
+/** Configure shared memory window in MPU state of process.
+ * Shared window occupies region reserved for second memory-mapped IO range
+ * of the process. Hardware is not touched, see @ref mpu_load_shared_window().
+ * @param state MPU state of process
+ * @param base base address of window, NULL to remove window
+ * @param size size of window, power of two, base has to be aligned to it
+ * @param flags access rights, see @ref MPU_Flags
+ * @returns E_OK if window was configured, E_BUSY if process uses second
+ * memory-mapped IO range, error code if MPU can't map window
+ */
+int mpu_set_shared_window(MPU_State * state, const void * base, uint32_t size, uint8_t flags);
+
+/** Load shared memory window of process into MPU.
+ * Used if window of process which is currently running changes.
+ * @param state MPU state of process
+ * @returns E_OK
+ */
+int mpu_load_shared_window(const MPU_State * state);
+
+/** Check if running thread can access memory.
+ * Used by kernel to validate addresses passed by thread before kernel
+ * accesses them on behalf of the thread. Memory protection configuration
+ * currently loaded is evaluated as if the thread accessed the memory itself.
+ * @param base start of memory block
+ * @param size size of memory block
+ * @param write true if block is going to be written
+ * @returns true if thread can access whole block or memory protection is
+ * not enabled, false otherwise
+ */
+bool mpu_user_accessible(const void * base, uint32_t size, bool write);
+
 /** @} */
 
@@ -20,4 +20,51 @@ int os_rpc_call(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3);
  */
 int os_rpc_return(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3);
 
+/** Kernel implementation of timed rpc_call syscall.
+ * This syscall has to perform the same as @ref os_rpc_call() does. Additionally
+ * it has to arm deadline using @ref os_rpc_deadline_set() and disarm it if call could
+ * not be performed. Implementation of @ref os_rpc_return() has to call
+ * @ref os_rpc_deadline_clear() when returning into the caller's frame.
+ */
+int os_rpc_call_timed(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3);
+
+/** Return from RPC call immediately.
+ * This has to throw away all the context created since the RPC call was made and
+ * make thread return from the RPC call, given the caller's exception frame. Thread
+ * may or may not be currently running. If it is running, then MPU setup has to be
+ * restored according to thread's RPC stack, which is already unwound by the caller.
+ * Thread may also be switched out with its context not saved yet, see
+ * @ref os_context_live_thread().
+ * @param thread_id thread whose call is aborted
+ * @param frame address of caller's exception frame, as passed to @ref os_rpc_deadline_set()
+ * @param retval value returned from the RPC call
+ */
+void os_rpc_unwind(Thread_t thread_id, uint32_t * frame, int retval);
+
+/** Kernel implementation of asynchronous rpc_call syscall.
+ * This syscall has to retrieve service, method ID and completion signal passed to
+ * @ref _rpc_call_async() and hand them over to @ref os_rpc_request_submit().
+ */
+int os_rpc_call_async(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3);
+
+/** Kernel implementation of queued rpc_call syscall.
+ * This syscall has to retrieve service and method ID passed to
+ * @ref _rpc_call_queued() and hand them over to @ref os_rpc_request_call().
+ */
+int os_rpc_call_queued(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3);
+
+/** Kernel implementation of rpc_serve syscall.
+ * This syscall has to fetch next request using @ref os_rpc_request_fetch() and
+ * transfer control to requested method so that when method returns,
+ * @ref os_rpc_async_return() is triggered. If there is no request, then thread
+ * shall wait using @ref os_rpc_request_wait() and retry once woken up.
+ */
+int os_rpc_serve(void);
+
+/** Kernel implementation of rpc_async_return syscall.
+ * This syscall has to pass return value of method to @ref os_rpc_request_complete()
+ * and return control back to the code which called @ref rpc_serve().
+ */
+int os_rpc_async_return(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3);
+
 /// @}
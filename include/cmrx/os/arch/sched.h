@@ -30,6 +30,17 @@ uint32_t * os_thread_populate_stack(int stack_id, unsigned stack_size, entrypoin
  */
 bool schedule_context_switch(uint32_t current_task, uint32_t next_task);
 
+/** Get thread whose context is held by CPU.
+ * Context of this thread is not saved on its stack. Its exception frame is
+ * on top of process stack instead. This is the current thread, unless task
+ * switch is pending, in which case it is the outgoing thread.
+ * Stack pointer stored in control block of this thread is stale, kernel
+ * must not build anything on its stack.
+ * @returns thread whose context is not saved or NULL if context of all
+ * threads is saved
+ */
+struct OS_thread_t * os_context_live_thread(void);
+
 /** Create process using process definition.
  * Takes process definition and initializes MPU regions for process out of it.
  * @param process_id ID of process to be initialized
@@ -51,4 +62,40 @@ int os_process_create(Process_t process_id, const struct OS_process_definition_t
  */
 __attribute__((naked,noreturn)) void os_boot_thread(Thread_t boot_thread);
 
+/** Read free-running timestamp counter.
+ * Used by kernel instrumentation to measure short time intervals. Counter
+ * shall run at CPU clock if platform provides means to do so, otherwise it
+ * may run at lower resolution. Counter is allowed to wrap around.
+ * @returns current value of the counter
+ */
+uint32_t os_cycle_count(void);
+
+/** Set return value of syscall thread is blocked in.
+ * Used to pass result to thread which is blocked inside a syscall. Return
+ * value shall be written into the saved context of thread so that thread
+ * observes it once it is resumed. Thread may not have been switched out yet
+ * if it got woken up while the task switch was still pending. Then the
+ * value has to be written where its context will be saved from.
+ * @param thread_id ID of thread which is blocked
+ * @param value value returned from the syscall
+ */
+void os_set_syscall_return_value(Thread_t thread_id, int value);
+
+/** Atomically compare and exchange word.
+ * Must be safe against preemption by interrupt service routines of any
+ * priority. Used to let interrupt service routines cooperate without
+ * disabling interrupts, where platform allows it.
+ * @param addr address of word
+ * @param expected value word is expected to contain
+ * @param desired value stored into word if it contains expected value
+ * @returns true if value was exchanged, false if word didn't contain expected value
+ */
+bool os_atomic_compare_exchange(volatile uint32_t * addr, uint32_t expected, uint32_t desired);
+
+/** Make kernel process requests posted by interrupt service routines.
+ * Kernel shall call @ref os_isr_drain() on next suitable moment, once no
+ * interrupt service routine is executing.
+ */
+void os_pend_isr_requests(void);
+
 /** @} */
@@ -0,0 +1,36 @@
+/** @defgroup os_buffer Buffer pool
+ *
+ * @ingroup os
+ *
+ * Kernel side of zero-copy buffer pool. Whole pool is one MPU region where
+ * each buffer occupies one subregion. Every process has its own view of
+ * the pool, which enables only subregions of buffers owned by the process.
+ * Transfer of ownership only updates views of both processes.
+ * @{
+ */
+#pragma once
+
+#include <stdint.h>
+#include <cmrx/defines.h>
+
+/** Kernel implementation of buffer_alloc syscall.
+ * See @ref buffer_alloc for details.
+ */
+int os_buffer_alloc(void);
+
+/** Kernel implementation of buffer_address syscall.
+ * See @ref buffer_address for details.
+ */
+void * os_buffer_address(int buffer);
+
+/** Kernel implementation of buffer_send syscall.
+ * See @ref buffer_send for details.
+ */
+int os_buffer_send(int buffer, Thread_t thread);
+
+/** Kernel implementation of buffer_free syscall.
+ * See @ref buffer_free for details.
+ */
+int os_buffer_free(int buffer);
+
+/** @} */
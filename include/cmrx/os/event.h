@@ -0,0 +1,56 @@
+/** @defgroup os_event Event groups
+ *
+ * @ingroup os
+ *
+ * Kernel side of event groups. Event group holds 32 flags. Threads block
+ * until any or all flags they are interested in are set. Flags can be set
+ * both from threads and from interrupt service routines.
+ * @{
+ */
+#pragma once
+
+#include <stdint.h>
+
+/** Get address of event group used as object to wait for.
+ * @param group event group handle
+ * @returns address of event group or NULL if handle is not valid
+ */
+const void * os_event_group_object(int group);
+
+/** Check if event group satisfies wait condition without waiting.
+ * If condition is satisfied and EVENT_WAIT_CLEAR is requested, then flags
+ * waited for are cleared.
+ * @param group event group handle
+ * @param bits mask of flags
+ * @param flags wait flags
+ * @returns flags of event group before they were cleared if condition is
+ * satisfied. 0 if it is not satisfied or handle is not valid.
+ */
+uint32_t os_event_group_poll(int group, uint32_t bits, unsigned flags);
+
+/** Kernel implementation of event_group_create syscall.
+ * See @ref event_group_create for details.
+ */
+int os_event_group_create(void);
+
+/** Kernel implementation of event_group_delete syscall.
+ * See @ref event_group_delete for details.
+ */
+int os_event_group_delete(int group);
+
+/** Kernel implementation of event_group_set syscall.
+ * See @ref event_group_set for details.
+ */
+int os_event_group_set(int group, uint32_t bits);
+
+/** Kernel implementation of event_group_clear syscall.
+ * See @ref event_group_clear for details.
+ */
+int os_event_group_clear(int group, uint32_t bits);
+
+/** Kernel implementation of event_group_wait syscall.
+ * See @ref event_group_wait for details.
+ */
+int os_event_group_wait(int group, uint32_t * bits, unsigned flags, unsigned microseconds);
+
+/** @} */
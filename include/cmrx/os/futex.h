@@ -0,0 +1,38 @@
+/** @defgroup os_futex Futex waiting
+ *
+ * @ingroup os
+ *
+ * Kernel side of futexes. Threads can block until value of word in memory
+ * changes and wake each other up once they changed the value.
+ *
+ * Kernel doesn't interpret value of the word anyhow. It only checks that the
+ * word still contains value caller expects before thread is put to sleep.
+ * @{
+ */
+#pragma once
+
+#include <stdint.h>
+
+/** Kernel implementation of futex_wait syscall.
+ * See @ref futex_wait for details.
+ */
+int os_futex_wait(uint32_t * address, uint32_t expected, unsigned microseconds);
+
+/** Kernel implementation of futex_wake syscall.
+ * See @ref futex_wake for details.
+ */
+int os_futex_wake(uint32_t * address, unsigned count);
+
+/** Give one unit to semaphore on behalf of interrupt service routine.
+ * Kernel counterpart of @ref sem_give() used by @ref isr_sem_give().
+ * @param value address of semaphore value
+ * @returns E_OK, E_MISALIGNED if address is not aligned
+ */
+int os_sem_give(uint32_t * value);
+
+/** Kernel implementation of futex_requeue syscall.
+ * See @ref futex_requeue for details.
+ */
+int os_futex_requeue(uint32_t * address, unsigned count, uint32_t * target);
+
+/** @} */
@@ -0,0 +1,14 @@
+/** @ingroup os_isr
+ * @{
+ */
+#pragma once
+
+/** Process requests posted by interrupt service routines.
+ *
+ * Executes all requests interrupt service routines posted since the
+ * last call. Must be called from kernel context with interrupts
+ * disabled, when no interrupt service routine is executing.
+ */
+void os_isr_drain(void);
+
+/** @} */
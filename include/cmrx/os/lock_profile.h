@@ -0,0 +1,101 @@
+/** @defgroup os_lock_profile Lock contention profiling
+ *
+ * @ingroup os_futex
+ *
+ * Optional instrumentation of futexes.
+ *
+ * If @ref KERNEL_HAS_LOCK_PROFILE is defined, then @ref futex_lock() and
+ * @ref futex_unlock() report each acquisition and release to the kernel.
+ * Kernel additionally records every sleep in @ref futex_wait(). For each
+ * lock address kernel counts acquisitions, acquisitions which had to sleep,
+ * sleeps, cumulative time spent waiting, longest time lock was held, last
+ * owner and mask of threads which ever slept on the lock. Sleeps are
+ * recorded for any primitive built on top of futex words.
+ *
+ * Statistics are kept in kernel memory in @ref os_lock_profile, which has
+ * self-describing layout. It is meant to be dumped by debugger as binary
+ * blob, see `tools/lock_profile.gdb` and `tools/lock_profile.py`.
+ *
+ * Times are in CPU cycles where cycle counter is available, in
+ * microseconds otherwise.
+ * @{
+ */
+#pragma once
+
+#include <stdint.h>
+#include <cmrx/defines.h>
+#include <conf/kernel.h>
+
+/** Magic value identifying lock profile blob, "LKPF" in memory */
+#define LOCK_PROFILE_MAGIC		0x46504B4C
+
+/** Version of lock profile blob layout */
+#define LOCK_PROFILE_VERSION	1
+
+/** Statistics of one lock.
+ */
+struct OS_lock_stat_t {
+	/** Address of lock, 0 if entry is unused */
+	uint32_t lock;
+	/** Number of acquisitions */
+	uint32_t acquisitions;
+	/** Number of acquisitions, which had to sleep */
+	uint32_t contended;
+	/** Number of sleeps in futex_wait() on lock address */
+	uint32_t sleeps;
+	/** Cumulative time from first sleep to acquisition */
+	uint32_t wait_time;
+	/** Longest time lock was held */
+	uint32_t hold_max;
+	/** Time of ongoing acquisition */
+	uint32_t acquired;
+	/** Mask of threads which slept on lock */
+	uint32_t waiters;
+	/** Thread which acquired the lock last, 0xFF if none yet */
+	uint8_t owner;
+	/** Padding, keeps record size multiple of 4 */
+	uint8_t reserved[3];
+};
+
+/** Lock profile as dumped for the host.
+ */
+struct OS_lock_profile_t {
+	/** Always @ref LOCK_PROFILE_MAGIC */
+	uint32_t magic;
+	/** Always @ref LOCK_PROFILE_VERSION */
+	uint16_t version;
+	/** Size of one record in bytes */
+	uint16_t record_size;
+	/** Amount of records */
+	uint16_t entries;
+	/** Non-zero if times are CPU cycles, zero if microseconds */
+	uint16_t cycles;
+	/** Amount of events which did not fit into table */
+	uint32_t dropped;
+	/** Per-lock statistics */
+	struct OS_lock_stat_t stats[OS_LOCK_PROFILE_ENTRIES];
+};
+
+#ifdef KERNEL_HAS_LOCK_PROFILE
+
+/** Kernel implementation of lock_profile syscall.
+ * @param lock address of lock
+ * @param event either LOCK_PROFILE_ACQUIRED or LOCK_PROFILE_RELEASED
+ * @returns E_OK, E_INVALID if event is not known
+ */
+int os_lock_profile_event(const void * lock, unsigned event);
+
+/** Record that thread is going to sleep on lock.
+ * Called from futex wait path.
+ * @param thread_id thread going to sleep
+ * @param lock address thread sleeps on
+ */
+void os_lock_profile_wait(Thread_t thread_id, const void * lock);
+
+#else
+
+#define os_lock_profile_wait(thread_id, lock)
+
+#endif
+
+/** @} */
@@ -32,4 +32,20 @@ enum MPU_Flags {
 	MPU_RW
 };
 
+/** Memory window mapped into address space of single thread.
+ * Window is one additional MPU region which follows the thread. It is used
+ * to grant thread temporary access to memory owned by kernel, such as
+ * message received without copying or buffers owned by the process.
+ */
+struct OS_MPU_window_t {
+	/** Base address of window, NULL if nothing is mapped */
+	const void * base;
+	/** Size of window. Has to satisfy MPU region constraints */
+	uint32_t size;
+	/** Access rights, see @ref MPU_Flags */
+	uint8_t flags;
+	/** Mask of enabled eighths of window, 0xFF if whole window is mapped */
+	uint8_t subregions;
+};
+
 /** @} */
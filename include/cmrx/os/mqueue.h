@@ -0,0 +1,94 @@
+/** @defgroup os_mqueue Message queues
+ *
+ * @ingroup os
+ *
+ * Kernel side of message queues. Messages are stored in a static pool of
+ * fixed-size slots shared by all queues. Queue reserves slots for its depth
+ * at creation time, so a queue which accepts message always gets a slot.
+ *
+ * Blocked threads are served directly: sender hands message over to waiting
+ * receiver and receiver which frees space accepts message of waiting sender.
+ * Interrupt service routines reserve a slot and copy message into it on their
+ * own, queueing of the slot is deferred until kernel drains ISR requests.
+ * @{
+ */
+#pragma once
+
+#include <stdint.h>
+#include <cmrx/defines.h>
+
+/** Reserve slot in queue and fill it with message.
+ * Safe to be called from interrupt service routine. Slot is not queued,
+ * it has to be passed to @ref os_mqueue_post() or @ref os_mqueue_cancel().
+ * @param queue handle of message queue
+ * @param message message copied into slot
+ * @returns index of slot, negative value of E_INVALID if handle is not valid,
+ * negative value of E_BUSY if queue is full
+ */
+int os_mqueue_reserve(int queue, const void * message);
+
+/** Queue slot reserved by @ref os_mqueue_reserve().
+ * @param queue handle of valid message queue
+ * @param slot index of slot
+ */
+void os_mqueue_post(int queue, unsigned slot);
+
+/** Get generation of queue handle.
+ * Safe to be called from interrupt service routine.
+ * @param queue handle of message queue
+ * @returns value which changes whenever queue is deleted
+ */
+uint8_t os_mqueue_generation(int queue);
+
+/** Queue slot reserved by interrupt service routine.
+ * If queue was deleted since slot was reserved, then nothing is done as
+ * deletion released the slot already.
+ * @param queue handle of message queue
+ * @param slot index of slot
+ * @param generation generation of queue at the time slot was reserved
+ */
+void os_mqueue_post_checked(int queue, unsigned slot, uint8_t generation);
+
+/** Return slot reserved by @ref os_mqueue_reserve() without queueing it.
+ * Safe to be called from interrupt service routine.
+ * @param queue handle of message queue
+ * @param slot index of slot
+ */
+void os_mqueue_cancel(int queue, unsigned slot);
+
+/** Release message mapped by thread which is being terminated.
+ * @param thread_id thread being terminated
+ */
+void os_mqueue_thread_exit(Thread_t thread_id);
+
+/** Kernel implementation of mqueue_create syscall.
+ * See @ref mqueue_create for details.
+ */
+int os_mqueue_create(unsigned depth, unsigned message_size);
+
+/** Kernel implementation of mqueue_delete syscall.
+ * See @ref mqueue_delete for details.
+ */
+int os_mqueue_delete(int queue);
+
+/** Kernel implementation of mqueue_send syscall.
+ * See @ref mqueue_send for details.
+ */
+int os_mqueue_send(int queue, const void * message, unsigned microseconds);
+
+/** Kernel implementation of mqueue_receive syscall.
+ * See @ref mqueue_receive for details.
+ */
+int os_mqueue_receive(int queue, void * message, unsigned microseconds);
+
+/** Kernel implementation of mqueue_receive_map syscall.
+ * See @ref mqueue_receive_map for details.
+ */
+int os_mqueue_receive_map(int queue, const void ** message, unsigned microseconds);
+
+/** Kernel implementation of mqueue_release syscall.
+ * See @ref mqueue_release for details.
+ */
+int os_mqueue_release(void);
+
+/** @} */
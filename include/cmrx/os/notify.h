@@ -0,0 +1,133 @@
+/** @defgroup os_notify Waiting for objects
+ *
+ * @ingroup os
+ *
+ * Kernel mechanism which allows threads to block until some object is notified.
+ *
+ * Any address known to the kernel can serve as an object thread can wait for.
+ * Waiting thread is removed from scheduling until someone notifies the object.
+ * If there are more threads waiting for the same object, then notification
+ * always wakes up the one having highest priority.
+ *
+ * Thread can also wait for multiple objects at once. Then it is woken up by
+ * notification of any of them and its syscall returns index of the object
+ * notified.
+ * @{
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <cmrx/defines.h>
+
+/** Block current thread until object is notified.
+ *
+ * Puts current thread into waiting state. Thread won't be scheduled until
+ * someone calls @ref os_notify_object() on the same object.
+ * @param object address of object thread wants to wait for
+ * @returns E_OK. Thread switch will happen once the calling syscall returns.
+ */
+int os_wait_for_object(const void * object);
+
+/** Block current thread until object is notified or timeout expires.
+ *
+ * Works as @ref os_wait_for_object() but thread is made ready again once
+ * timeout expires even if object wasn't notified. Syscall can tell these two
+ * cases apart by returning value meaning timeout and letting the notifier
+ * overwrite it using @ref os_set_syscall_return_value().
+ * @param object address of object thread wants to wait for
+ * @param microseconds timeout of wait, WAIT_FOREVER if thread waits without timeout
+ * @returns E_OK if thread was put into waiting state, E_NOTAVAIL if timeout
+ * can't be armed. Thread doesn't wait in the latter case.
+ */
+int os_wait_for_object_timeout(const void * object, unsigned microseconds);
+
+/** Block current thread until any of multiple objects is notified.
+ *
+ * Objects have to be filled into wait list of current thread before this
+ * is called. Otherwise works as @ref os_wait_for_object_timeout(). Whoever
+ * notifies any of objects sets syscall return value to index of the object
+ * in wait list.
+ * @param count amount of entries in wait list of current thread
+ * @param microseconds timeout of wait, WAIT_FOREVER if thread waits without timeout
+ * @returns E_OK if thread was put into waiting state, E_NOTAVAIL if timeout
+ * can't be armed. Thread doesn't wait in the latter case.
+ */
+int os_wait_for_objects_timeout(unsigned count, unsigned microseconds);
+
+/** Find out if thread waits for object.
+ * @param thread_id thread being examined
+ * @param object address of object
+ * @returns index of object in thread's wait list, 0 if thread waits for
+ * single object, -1 if thread doesn't wait for the object.
+ */
+int os_wait_entry(Thread_t thread_id, const void * object);
+
+/** Handle expiration of waiting timeout.
+ *
+ * Called by timer when timeout armed by @ref os_wait_for_object_timeout() expires.
+ * @param thread_id thread whose waiting timed out
+ */
+void os_wait_timeout_expired(Thread_t thread_id);
+
+/** Wake up thread waiting for object.
+ *
+ * If there is any thread waiting for given object, then the one with
+ * highest priority is made ready. Scheduler is invoked so if the woken
+ * thread has higher priority than the current one, then it will preempt
+ * it.
+ * @param object address of object being notified
+ * @returns true if any thread was woken up, false if nobody waits for the object
+ */
+bool os_notify_object(const void * object);
+
+/** Wake up specific waiting thread.
+ *
+ * Used by objects which need to decide which of their waiters shall be
+ * woken up. Thread must be waiting for an object.
+ * @param thread_id thread being woken up
+ */
+void os_notify_thread(Thread_t thread_id);
+
+/** Wake up specific waiting thread and set its syscall return value.
+ *
+ * If thread waits for multiple objects, then its syscall returns index
+ * of the object instead of value.
+ * @param thread_id thread being woken up
+ * @param entry index of object in wait list as returned by @ref os_wait_entry()
+ * @param value value returned by the woken thread's syscall
+ */
+void os_notify_waiter(Thread_t thread_id, int entry, int value);
+
+/** Wake up thread waiting for object and set its syscall return value.
+ *
+ * Works as @ref os_notify_object() but woken thread returns value from
+ * the syscall it was blocked in.
+ * @param object address of object being notified
+ * @param value value returned by the woken thread's syscall
+ * @returns true if any thread was woken up, false if nobody waits for the object
+ */
+bool os_notify_object_value(const void * object, int value);
+
+/** Wake up thread waiting for object which is being deleted.
+ *
+ * Works as @ref os_notify_object_value() but thread waiting for multiple
+ * objects returns negative value of E_DELETED instead of index of the object,
+ * so it doesn't mistake deletion for the object becoming ready.
+ * @param object address of object being deleted
+ * @param value value returned by the woken thread's syscall if it waits for
+ * single object
+ * @returns true if any thread was woken up, false if nobody waits for the object
+ */
+bool os_notify_object_deleted(const void * object, int value);
+
+/** Kernel implementation of notify_give syscall.
+ * See @ref notify_give for details.
+ */
+int os_notify_give(Thread_t thread_id, unsigned index);
+
+/** Kernel implementation of notify_take syscall.
+ * See @ref notify_take for details.
+ */
+int os_notify_take(unsigned index, bool clear, unsigned microseconds);
+
+/** @} */
@@ -108,4 +108,201 @@ int os_rpc_call(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3);
  */
 int os_rpc_return(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3);
 
+/** Kernel implementation of timed rpc_call syscall.
+ *
+ * Works as @ref os_rpc_call() does, but also arms deadline for the call.
+ * If the call doesn't return before deadline expires, it is aborted.
+ */
+int os_rpc_call_timed(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3);
+
+/** Arm deadline for RPC call made by current thread.
+ * @param frame address of caller's exception frame
+ * @param microseconds time after which the call is aborted
+ * @returns E_OK if deadline was set. E_BUSY is returned if thread already has
+ * active deadline. E_NOTAVAIL is returned if there is no free timer slot.
+ */
+int os_rpc_deadline_set(uint32_t * frame, unsigned microseconds);
+
+/** Disarm deadline of RPC call made by current thread.
+ * Does nothing if deadline isn't bound to given caller's frame. This allows to call
+ * it on every return from RPC.
+ * @param frame address of caller's exception frame
+ */
+void os_rpc_deadline_clear(uint32_t * frame);
+
+/** Abort RPC call whose deadline expired.
+ *
+ * Removes processes entered since the call from thread's RPC stack, delivers
+ * cancellation notification to them and lets thread return from the call with
+ * E_TIMEOUT.
+ * @param thread_id thread whose deadline expired
+ */
+void os_rpc_deadline_expired(Thread_t thread_id);
+
+/** Kernel implementation of rpc_cancel_notify syscall.
+ *
+ * Registers thread which will be signalled when RPC call into current process is
+ * aborted due to deadline expiry.
+ * @param thread_id thread which will receive the signal
+ * @param signal signal number. Use number larger than 31 to cancel the registration.
+ * @returns E_OK. E_INVALID is returned if thread does not exist.
+ */
+int os_rpc_cancel_notify(Thread_t thread_id, uint32_t signal);
+
+/** States of asynchronous RPC request.
+ */
+enum RPC_Request_State {
+	/// Request slot is free
+	RPC_REQUEST_FREE = 0,
+	/// Request is queued and waits for server thread to pick it up
+	RPC_REQUEST_PENDING,
+	/// Server thread is executing the request
+	RPC_REQUEST_RUNNING,
+	/// Request has been executed, result waits for the caller to collect it
+	RPC_REQUEST_DONE
+};
+
+/** Flags of asynchronous RPC request.
+ */
+enum RPC_Request_Flags {
+	/// Caller is blocked until request is done, return value is passed directly to it
+	RPC_REQUEST_FLAG_BLOCKING = 1,
+	/// Nobody is interested in the result, request is released once done
+	RPC_REQUEST_FLAG_NOTIFY = 2
+};
+
+/** Asynchronous RPC request.
+ *
+ * Holds copy of arguments of RPC call which was queued for execution by
+ * server thread of target process rather than by migrating the calling thread.
+ */
+struct OS_RPC_request_t {
+	/** Service instance being called */
+	RPC_Service_t * service;
+	/** Index of method in service vtable */
+	unsigned method;
+	/** Copy of arguments passed to the method */
+	uint32_t args[4];
+	/** Value returned by the method */
+	int retval;
+	/** Sequence number used to keep requests ordered and tokens unique */
+	uint32_t sequence;
+	/** State of this request, see @ref RPC_Request_State */
+	uint8_t state;
+	/** Process owning the service */
+	Process_t process;
+	/** Thread which queued the request */
+	Thread_t caller;
+	/** Thread which executes the request */
+	Thread_t server;
+	/** Signal sent to the caller once request is done */
+	uint8_t signal;
+	/** Request flags, see @ref RPC_Request_Flags */
+	uint8_t flags;
+};
+
+/** Queue asynchronous RPC request.
+ *
+ * Validates the service, stores copy of the call into free request slot and
+ * wakes up server thread of process owning the service, if there is any waiting.
+ * @param service address of service instance
+ * @param method index of method in service vtable
+ * @param args four arguments passed to the method
+ * @param signal signal delivered to calling thread once the request is done.
+ * Use value larger than 31 if no signal should be delivered.
+ * @param flags request flags, see @ref RPC_Request_Flags
+ * If @ref RPC_REQUEST_FLAG_NOTIFY is set and the same notification is already
+ * pending, then no new request is queued.
+ * @returns non-negative completion token or negative error code. -E_BUSY is
+ * returned if there is no free request slot or if process owning the service
+ * already has @ref OS_RPC_QUEUE_DEPTH requests pending.
+ */
+int os_rpc_request_submit(RPC_Service_t * service, unsigned method, const uint32_t * args, uint8_t signal, uint8_t flags);
+
+/** Queue RPC request and wait for its completion.
+ *
+ * Queues blocking request and puts calling thread into waiting state. Once
+ * request is done, the return value of method is written directly as the
+ * return value of calling syscall.
+ * @param service address of service instance
+ * @param method index of method in service vtable
+ * @param args four arguments passed to the method
+ * @returns E_OK if request has been queued, negative error code otherwise.
+ * If request has been queued, then this value is overwritten once it is done.
+ */
+int os_rpc_request_call(RPC_Service_t * service, unsigned method, const uint32_t * args);
+
+/** Take next request queued for process.
+ *
+ * Finds the oldest pending request targeted at given process and marks it as
+ * being executed by given thread.
+ * @param process_id process whose requests are searched
+ * @param server thread which will execute the request
+ * @returns address of request or NULL if there is no pending request
+ */
+struct OS_RPC_request_t * os_rpc_request_fetch(Process_t process_id, Thread_t server);
+
+/** Mark request executed by thread as done.
+ *
+ * Stores the return value and notifies the caller.
+ * @param server thread which executed the request
+ * @param retval value returned by the method
+ */
+void os_rpc_request_complete(Thread_t server, int retval);
+
+/** Wait until some request for current process is queued.
+ * @returns E_OK
+ */
+int os_rpc_request_wait(void);
+
+/** Kernel implementation of _rpc_poll syscall.
+ *
+ * Checks state of request identified by token. Request is left untouched,
+ * its return value is collected by @ref os_rpc_result().
+ * @param token completion token returned by asynchronous RPC call
+ * @returns E_OK if request is done, E_BUSY if it is still queued or running,
+ * E_INVALID if token does not identify request made by calling thread.
+ */
+int os_rpc_poll(int token);
+
+/** Kernel implementation of _rpc_result syscall.
+ *
+ * Returns value the method of finished request returned and releases the
+ * request slot. Value is passed back through syscall return value, so
+ * kernel never writes into memory of the caller.
+ * @param token completion token for which @ref os_rpc_poll() returned E_OK
+ * @returns return value of the method, negative value of E_INVALID if token
+ * does not identify finished request made by calling thread
+ */
+int os_rpc_result(int token);
+
+/** Kernel implementation of asynchronous rpc_call syscall.
+ *
+ * Retrieves the 5th to 7th argument passed to @ref _rpc_call_async() from thread
+ * stack and queues the request. If @ref RPC_NOTIFY_FLAG is set in the 7th argument,
+ * then the request is queued as one-way notification.
+ */
+int os_rpc_call_async(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3);
+
+/** Kernel implementation of queued rpc_call syscall.
+ *
+ * Retrieves the 5th and 6th argument passed to @ref _rpc_call_queued() from thread
+ * stack, queues the request and blocks the caller until the request is done.
+ */
+int os_rpc_call_queued(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3);
+
+/** Kernel implementation of rpc_serve syscall.
+ *
+ * If there is any request queued for current process, then stack frame for calling
+ * the requested method is synthesized. Otherwise thread waits for request to arrive.
+ */
+int os_rpc_serve(void);
+
+/** Kernel implementation of rpc_async_return syscall.
+ *
+ * Unwinds stack frame used to call method of asynchronous request and stores the
+ * return value into the request.
+ */
+int os_rpc_async_return(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3);
+
 /** @} */
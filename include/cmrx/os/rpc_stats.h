@@ -0,0 +1,99 @@
+/** @defgroup os_rpc_stats RPC statistics and tracing
+ *
+ * @ingroup os_rpc
+ *
+ * Optional instrumentation of synchronous RPC calls.
+ *
+ * If @ref KERNEL_HAS_RPC_STATISTICS is defined, then kernel counts calls and
+ * accumulates inclusive time spent in each method, separately for each
+ * (process, vtable, method) triplet. If @ref KERNEL_HAS_RPC_TRACE is defined,
+ * then every call and return is additionally recorded into a ring buffer.
+ *
+ * Both structures are kept in kernel memory and are meant to be read by
+ * debugger. See `tools/rpc_trace.gdb` and `tools/rpc_callgraph.py`.
+ *
+ * Timestamps are in CPU cycles where cycle counter is available, in
+ * microseconds otherwise.
+ * @{
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <cmrx/defines.h>
+#include <cmrx/os/rpc.h>
+#include <conf/kernel.h>
+
+/** Statistics of one RPC method.
+ */
+struct OS_RPC_stat_t {
+	/** VTable of service, NULL if entry is unused */
+	VTable_t * vtable;
+	/** Number of calls made */
+	uint32_t calls;
+	/** Inclusive time spent in method, including nested calls */
+	uint32_t time;
+	/** Longest single call */
+	uint32_t time_max;
+	/** Index of method in vtable */
+	uint16_t method;
+	/** Process owning the service */
+	Process_t process;
+};
+
+/** Kinds of RPC trace events.
+ */
+enum RPC_Trace_Event {
+	/// Thread entered RPC method
+	RPC_TRACE_CALL = 0,
+	/// Thread returned from RPC method
+	RPC_TRACE_RETURN,
+	/// RPC method was aborted
+	RPC_TRACE_ABORT
+};
+
+/** One record in RPC trace buffer.
+ */
+struct OS_RPC_trace_t {
+	/** Time at which event happened */
+	uint32_t timestamp;
+	/** VTable of service */
+	VTable_t * vtable;
+	/** Index of method in vtable */
+	uint16_t method;
+	/** Event kind, see @ref RPC_Trace_Event */
+	uint8_t event;
+	/** Thread performing the call */
+	Thread_t thread;
+	/** Process owning the service */
+	Process_t process;
+	/** Depth of thread's RPC stack including this call */
+	uint8_t depth;
+};
+
+#if defined(KERNEL_HAS_RPC_STATISTICS) || defined(KERNEL_HAS_RPC_TRACE)
+
+/** Record entry into RPC method.
+ * Has to be called after process has been pushed onto thread's RPC stack.
+ * @param thread_id thread performing the call
+ * @param process_id process owning the service
+ * @param vtable vtable of service
+ * @param method index of method in vtable
+ */
+void os_rpc_stats_enter(Thread_t thread_id, Process_t process_id, VTable_t * vtable, unsigned method);
+
+/** Record return from RPC method.
+ * Has to be called before process is popped from thread's RPC stack.
+ * @param thread_id thread performing the call
+ * @param aborted true if method did not return on its own
+ */
+void os_rpc_stats_leave(Thread_t thread_id, bool aborted);
+
+#else
+
+#define os_rpc_stats_enter(thread_id, process_id, vtable, method)
+#define os_rpc_stats_leave(thread_id, aborted)
+
+#endif
+
+/** @} */
@@ -13,6 +13,7 @@
 #include <cmrx/defines.h>
 #include <conf/kernel.h>
 #include <arch/mpu.h>
+#include <cmrx/os/mpu.h>
 
 /** List of states in which thread can be.
  */
@@ -37,7 +38,14 @@ enum ThreadState {
 	THREAD_STATE_FINISHED,
 	/** Thread is blocked waitihg for other thread to finish.
 	 */
-	THREAD_STATE_BLOCKED_JOINING
+	THREAD_STATE_BLOCKED_JOINING,
+	/** Thread is waiting for some kernel object to be notified.
+	 * Address of object being waited for is stored in @ref OS_thread_t::block_object.
+	 * Thread is made ready again by calling @ref os_notify_object() on this object.
+	 * If thread waits for multiple objects, then notification of any of them
+	 * makes it ready.
+	 */
+	THREAD_STATE_WAITING
 };
 
 /** Prototype for thread entrypoint function.
@@ -49,14 +57,41 @@ enum ThreadState {
  */
 typedef int (entrypoint_t)(void *);
 
+/** Maximal depth of nested RPC calls. */
+#define OS_RPC_MAX_DEPTH		8
+
 /** RPC call owner process stack.
- * This stack records owners of nested RPC calls. It can accomodate up to 8 owners
- * which means 8 nested RPC calls.
+ * This stack records owners of nested RPC calls. It can accomodate up to
+ * @ref OS_RPC_MAX_DEPTH owners which means as many nested RPC calls. First
+ * entry holds current depth of the stack.
  */
-typedef Process_t OS_RPC_stack[8];
+typedef Process_t OS_RPC_stack[OS_RPC_MAX_DEPTH + 1];
 
 struct OS_process_t;
 
+#ifdef KERNEL_HAS_SIGNAL_QUEUE
+/** Signal queued for delivery using sigqueue(). */
+struct OS_signal_entry_t {
+	/** Value passed to signal handler */
+	uint32_t value;
+	/** Signal number */
+	uint8_t signo;
+};
+#endif
+
+/** Object thread waits for.
+ * Single object waits only use the first entry, and only if object needs
+ * to know what exactly thread waits for.
+ */
+struct OS_wait_entry_t {
+	/** Address of object */
+	unsigned long object;
+	/** Mask of bits thread waits for, meaning depends on object */
+	uint32_t mask;
+	/** Options of wait, meaning depends on object */
+	uint8_t flags;
+};
+
 /** Thread control block.
  *
  * This structure holds current status of the thread.
@@ -76,21 +111,37 @@ struct OS_thread_t {
 	/** Identification of object, which causes this thread to block.
 	 * This value if context-dependent. If thread is blocked joining other thread,
 	 * then this contains thread ID. If thread is blocked waiting for mutex, then
-	 * this contains mutex address.
+	 * this contains mutex address. If thread is waiting for an object, then this
+	 * contains address of the object.
 	 */
 	unsigned long block_object;
 
 	/** Ummmmm... */
 	OS_RPC_stack rpc_stack;
 
+	/** Caller's exception frame of RPC call having deadline set.
+	 * NULL if thread has no RPC deadline active.
+	 */
+	uint32_t * rpc_deadline_frame;
+
+	/** Sequence number of first RPC request queued after deadline was set.
+	 * Only requests queued from within the call having deadline are
+	 * affected once deadline expires.
+	 */
+	uint32_t rpc_deadline_sequence;
+
+	/** Depth of RPC stack at the moment RPC call having deadline was made. */
+	uint8_t rpc_deadline_depth;
+
 	/** Thread priority.
 	 * This is used by scheduler to decide which thread to run.
 	 */
 	uint8_t priority;
 
-	/** Address of signal handler to use.
+	/** Addresses of signal handlers indexed by signal number.
+	 * NULL means that signal is not handled.
 	 */
-	void (*signal_handler)(int);
+	void (*signal_handlers[32])(uint32_t, uint32_t);
 
 	/** Current pending signal bitmask.
 	 * Each set bit means that one signal has been delivered.
@@ -98,6 +149,39 @@ struct OS_thread_t {
 
 	uint32_t signals;
 
+	/** Notification counters given by notify_give() and taken by notify_take() */
+	uint32_t notifications[OS_THREAD_NOTIFICATIONS];
+
+	/** Objects thread waits for.
+	 * Only valid while thread is waiting. If thread waits for multiple objects
+	 * at once, then @ref block_object points to this list.
+	 */
+	struct OS_wait_entry_t wait_list[OS_WAIT_OBJECTS];
+
+	/** Amount of valid entries in @ref wait_list if thread waits for multiple objects */
+	uint8_t wait_count;
+
+	/** Where result of wait for single object is stored, if object has
+	 * more to tell than syscall return value. Meaning depends on object.
+	 */
+	void * wait_result;
+
+	/** Memory window mapped into thread's address space. */
+	struct OS_MPU_window_t mpu_window;
+
+#ifdef KERNEL_HAS_SIGNAL_QUEUE
+	/** Signals queued using sigqueue() waiting for delivery.
+	 * Organized as ring buffer starting at @ref signal_queue_head.
+	 */
+	struct OS_signal_entry_t signal_queue[OS_SIGNAL_QUEUE_DEPTH];
+
+	/** Index of oldest entry in signal queue */
+	uint8_t signal_queue_head;
+
+	/** Amount of entries in signal queue */
+	uint8_t signal_queue_count;
+#endif
+
 	/** Exit status after thread quit. */
 	int exit_status;
 	/** Owning process reference. */
@@ -161,6 +245,20 @@ struct OS_process_t {
 	MPU_State mpu;
 #endif
 
+	/** Thread notified if RPC call into this process is cancelled. */
+	Thread_t rpc_cancel_thread;
+
+	/** Signal delivered to @ref rpc_cancel_thread if RPC call into this
+	 * process is cancelled. Values larger than 31 mean no notification.
+	 */
+	uint8_t rpc_cancel_signal;
+
+	/** Part of buffer pool owned by the process.
+	 * Mapped into window of process threads, which don't have any other
+	 * window mapped.
+	 */
+	struct OS_MPU_window_t buffer_view;
+
 };
 
 /** Structure describing auto-spawned thread.
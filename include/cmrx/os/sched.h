@@ -111,6 +111,30 @@ int os_thread_kill(uint8_t thread_id, int status);
 
 int os_setpriority(uint8_t priority);
 
+/** Kernel implementation of priority_ceiling() syscall.
+ */
+int os_priority_ceiling(uint8_t ceiling);
+
+/** Map memory window into thread's address space.
+ * Replaces any window thread had mapped before. If thread is running, then
+ * window becomes accessible immediately, otherwise once thread is scheduled.
+ * @param thread_id thread window is mapped to
+ * @param base base address of window, NULL to unmap window
+ * @param size size of window
+ * @param flags access rights, see @ref MPU_Flags
+ * @returns E_OK if window was mapped, E_INVALID if thread doesn't exist,
+ * error code returned by @ref mpu_load_window() if MPU can't map window.
+ * Window is not kept then.
+ */
+int os_thread_map_window(Thread_t thread_id, const void * base, uint32_t size, uint8_t flags);
+
+/** Get window mapped into thread.
+ * Window base is NULL if thread has no window mapped.
+ * @param thread_id thread queried
+ * @returns window to be loaded when thread runs
+ */
+const struct OS_MPU_window_t * os_thread_window(Thread_t thread_id);
+
 /** Get address of stack.
  * @param stack_id ID of stack
  * @returns base address of stack
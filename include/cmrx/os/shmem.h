@@ -0,0 +1,28 @@
+/** @defgroup os_shmem Shared memory windows
+ *
+ * @ingroup os
+ *
+ * Kernel side of shared memory windows. Window is stored in memory protection
+ * state of both processes, so it is loaded along with the rest of process
+ * memory during context switch and RPC calls. Kernel is not involved in
+ * accesses to the window.
+ * @{
+ */
+#pragma once
+
+#include <stdint.h>
+#include <cmrx/defines.h>
+
+struct OS_process_definition_t;
+
+/** Kernel implementation of shmem_window_open syscall.
+ * See @ref shmem_window_open for details.
+ */
+int os_shmem_window_open(const struct OS_process_definition_t * peer, void * base, unsigned size, unsigned flags);
+
+/** Kernel implementation of shmem_window_close syscall.
+ * See @ref shmem_window_close for details.
+ */
+int os_shmem_window_close(int window);
+
+/** @} */
@@ -16,26 +16,59 @@ enum Signals {
 	SIGALARM
 };
 
+#include <cmrx/defines.h>
+
 struct OS_thread_t;
 
+/** Get mask of signals pending for thread.
+ * @param thread_id thread being examined
+ * @returns mask of signals pending either in pending mask or in signal queue
+ */
+uint32_t os_signal_pending(Thread_t thread_id);
+
 /** Internal implementation of signal delivery into thread context.
  *
- * As this routine is only designed to be called from pend_sv handler,
- * it has strict requirements on state of thread. It must be in state
- * just before being resumed.
+ * Builds frame calling handlers of signals on top of thread's saved context.
+ * Handlers are called in order of signal numbers, lowest first. Signals
+ * without handler are not delivered. Thread must not be executing at the
+ * moment, its context has to be stored on its stack. This is true for threads being resumed by pend_sv handler as well as
+ * for ready and stopped threads. Delivery can be repeated, frames then nest
+ * and the one delivered last runs first.
  * @param thread thread which gets signal handler injected
  * @param signals mask of signals being delivered
+ * @param value value passed to each signal handler
+ * @returns mask of signals delivered, 0 if delivery has to be postponed
+ */
+uint32_t os_deliver_signal(struct OS_thread_t * thread, uint32_t signals, uint32_t value);
+
+/** Deliver all signals pending for thread.
+ *
+ * Delivers queued signals and pending signal mask to handlers registered by
+ * thread. Same requirements on thread state as for @ref os_deliver_signal apply.
+ * Signals without handler and signals which can't be delivered right now
+ * remain pending. Queued signals without handler lose their value.
+ * @param thread thread signals are delivered to
  */
-void os_deliver_signal(struct OS_thread_t * thread, uint32_t signals);
+void os_deliver_pending_signals(struct OS_thread_t * thread);
 
 /** Kernel implementation of signal syscall.
  *
  */
-int os_signal(int signo, void (*sighandler)(int));
+int os_signal(int signo, void (*sighandler)(uint32_t, uint32_t));
 
 /** Kernel implementation of kill syscall.
  *
  */
 int os_kill(uint8_t thread, uint8_t signal_id);
 
+/** Kernel implementation of sigqueue syscall.
+ *
+ */
+int os_sigqueue(uint8_t thread, uint8_t signal_id, uint32_t value);
+
+/** Kernel implementation of sigwait syscall.
+ *
+ */
+int os_sigwait(uint32_t mask, unsigned microseconds);
+
 /** @} */
@@ -24,6 +24,41 @@ enum eSysCalls {
 	SYSCALL_SIGNAL,
 	SYSCALL_KILL,
 	SYSCALL_SETPRIORITY,
+	SYSCALL_RPC_CALL_ASYNC,
+	SYSCALL_RPC_SERVE,
+	SYSCALL_RPC_ASYNC_RETURN,
+	SYSCALL_RPC_POLL,
+	SYSCALL_RPC_RESULT,
+	SYSCALL_RPC_CALL_QUEUED,
+	SYSCALL_RPC_CALL_TIMED,
+	SYSCALL_RPC_CANCEL_NOTIFY,
+	SYSCALL_SIGQUEUE,
+	SYSCALL_SIGWAIT,
+	SYSCALL_FUTEX_WAIT,
+	SYSCALL_FUTEX_WAKE,
+	SYSCALL_EVENT_GROUP_CREATE,
+	SYSCALL_EVENT_GROUP_DELETE,
+	SYSCALL_EVENT_GROUP_SET,
+	SYSCALL_EVENT_GROUP_CLEAR,
+	SYSCALL_EVENT_GROUP_WAIT,
+	SYSCALL_WAIT_OBJECTS,
+	SYSCALL_NOTIFY_GIVE,
+	SYSCALL_NOTIFY_TAKE,
+	SYSCALL_PRIORITY_CEILING,
+	SYSCALL_FUTEX_REQUEUE,
+	SYSCALL_LOCK_PROFILE,
+	SYSCALL_MQUEUE_CREATE,
+	SYSCALL_MQUEUE_DELETE,
+	SYSCALL_MQUEUE_SEND,
+	SYSCALL_MQUEUE_RECEIVE,
+	SYSCALL_MQUEUE_RECEIVE_MAP,
+	SYSCALL_MQUEUE_RELEASE,
+	SYSCALL_BUFFER_ALLOC,
+	SYSCALL_BUFFER_ADDRESS,
+	SYSCALL_BUFFER_SEND,
+	SYSCALL_BUFFER_FREE,
+	SYSCALL_SHMEM_WINDOW_OPEN,
+	SYSCALL_SHMEM_WINDOW_CLOSE,
 	SYSCALL_RESET,
 	_SYSCALL_COUNT
 };
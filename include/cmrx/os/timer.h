@@ -9,6 +9,21 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <cmrx/defines.h>
+
+/** Kinds of timed events.
+ * Each thread can own at most one timed event of each kind at a time.
+ */
+enum TimerEntryKind {
+	/// One-shot sleep, thread is stopped until event fires
+	TIMER_SLEEP = 0,
+	/// Periodic interval timer, thread is continued each time event fires
+	TIMER_PERIODIC,
+	/// Deadline of RPC call, call is aborted if event fires
+	TIMER_DEADLINE,
+	/// Timeout of waiting for object, thread is made ready if event fires
+	TIMER_WAIT
+};
 
 /** Kernel implementation of usleep() syscall.
  * See \ref usleep for details on arguments.
@@ -20,6 +35,23 @@ int os_usleep(unsigned microseconds);
  */
 int os_setitimer(unsigned microseconds);
 
+/** Schedule timed event for thread.
+ * If thread already owns timed event of the same kind, it is replaced.
+ * If event is @ref TIMER_SLEEP, then thread is stopped.
+ * @param owner thread which will own the event
+ * @param microseconds delay until the event fires
+ * @param kind kind of event
+ * @returns 0 if event was scheduled, E_NOTAVAIL if there is no free slot
+ */
+int os_set_timed_event(Thread_t owner, unsigned microseconds, enum TimerEntryKind kind);
+
+/** Cancel timed event owned by thread.
+ * @param owner thread which owns the event
+ * @param kind kind of event
+ * @returns 0 if event was cancelled, E_NOTAVAIL if thread owns no such event
+ */
+int os_cancel_timed_event(Thread_t owner, enum TimerEntryKind kind);
+
 /** This routine initializes kernel scheduling subsystem.
  * It is necessary to call this routine before first call to
  * either timer syscalls, or \ref os_run_timer otherwise
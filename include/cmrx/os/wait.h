@@ -0,0 +1,19 @@
+/** @defgroup os_wait Waiting for multiple objects
+ *
+ * @ingroup os
+ *
+ * Kernel side of waiting for multiple sources at once. Sources are translated
+ * into objects and filled into wait list of the thread. Thread is then woken
+ * up by notification of any of these objects.
+ * @{
+ */
+#pragma once
+
+#include <cmrx/ipc/wait.h>
+
+/** Kernel implementation of wait_objects syscall.
+ * See @ref wait_objects for details.
+ */
+int os_wait_objects(const struct WaitObject * objects, unsigned count, unsigned microseconds);
+
+/** @} */
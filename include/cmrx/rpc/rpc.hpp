@@ -0,0 +1,290 @@
+/** @defgroup api_rpc_cpp C++ interface to remote procedure calls
+ *
+ * @ingroup api_rpc
+ *
+ * Header-only C++17 layer on top of the RPC mechanism.
+ *
+ * Interfaces are described by types rather than by structures of function
+ * pointers. Virtual method tables are generated at compile time as `constexpr`
+ * objects. Calls are checked against method prototypes by the compiler and compile
+ * down to direct call of @ref _rpc_call(). There is no limit on the amount of
+ * interfaces implemented in one translation unit.
+ *
+ * Interface is a type which lists its methods:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * struct Counter {
+ *     using add = cmrx::rpc::Method<Counter, 0, int(uint32_t)>;
+ *     using get = cmrx::rpc::Method<Counter, 1, int()>;
+ *     using methods = cmrx::rpc::Methods<add, get>;
+ * };
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Service implementing the interface derives from @ref cmrx::rpc::Service and
+ * binds its member functions to the interface methods in the vtable:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * class MyCounter : public cmrx::rpc::Service<Counter> {
+ * public:
+ *     using Service::Service;
+ *     int add(uint32_t value) { total += value; return total; }
+ *     int get() const { return total; }
+ * private:
+ *     uint32_t total = 0;
+ * };
+ *
+ * CMRX_RPC_VTABLE constexpr auto my_counter_vtable = cmrx::rpc::vtable<Counter, MyCounter, &MyCounter::add, &MyCounter::get>();
+ * MyCounter counter(my_counter_vtable);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Client then calls the service:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * int total = cmrx::rpc::call<Counter::add>(&counter, 5);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Methods can take up to 4 arguments. Arguments and return values have to be of
+ * integral, enumeration or pointer type which fits into general purpose register.
+ * @{
+ */
+#pragma once
+
+#include <stdint.h>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+extern "C" {
+#include <cmrx/ipc/rpc.h>
+}
+
+/** Place object into the section holding vtables of the process.
+ * Kernel only accepts RPC calls to services whose vtable is placed in this section.
+ */
+#define CMRX_RPC_VTABLE __attribute__((section(".vtable.")))
+
+namespace cmrx::rpc {
+
+namespace detail {
+
+/// Signature of vtable entry as expected by the kernel
+using Entry = int (*)(void * service, unsigned arg0, unsigned arg1, unsigned arg2, unsigned arg3);
+
+/// Type can be passed through general purpose register
+template <typename T, bool = std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>>
+inline constexpr bool is_word = sizeof(T) <= sizeof(uintptr_t);
+
+template <typename T>
+inline constexpr bool is_word<T, false> = false;
+
+/// Convert argument into machine word
+template <typename T>
+constexpr unsigned to_word(T value)
+{
+	if constexpr (std::is_pointer_v<T>)
+	{
+		return static_cast<unsigned>(reinterpret_cast<uintptr_t>(value));
+	}
+	else
+	{
+		return static_cast<unsigned>(value);
+	}
+}
+
+/// Convert machine word back into argument type
+template <typename T>
+constexpr T from_word(unsigned value)
+{
+	if constexpr (std::is_pointer_v<T>)
+	{
+		return reinterpret_cast<T>(static_cast<uintptr_t>(value));
+	}
+	else
+	{
+		return static_cast<T>(value);
+	}
+}
+
+template <typename Signature>
+struct Prototype;
+
+template <typename R, typename... Args>
+struct Prototype<R(Args...)> {
+	static_assert(sizeof...(Args) <= 4, "RPC methods can take at most 4 arguments!");
+	static_assert((is_word<Args> && ...), "RPC method arguments must be integers, enums or pointers fitting into register!");
+	static_assert(std::is_void_v<R> || is_word<R>, "RPC method must return void, integer, enum or pointer fitting into register!");
+};
+
+/// Signature of member function implementing interface method
+template <typename Member>
+struct MemberSignature;
+
+template <typename C, typename R, typename... Args>
+struct MemberSignature<R (C::*)(Args...)> {
+	using type = R(Args...);
+	using cls = C;
+};
+
+template <typename C, typename R, typename... Args>
+struct MemberSignature<R (C::*)(Args...) noexcept> : MemberSignature<R (C::*)(Args...)> {};
+
+template <typename C, typename R, typename... Args>
+struct MemberSignature<R (C::*)(Args...) const> : MemberSignature<R (C::*)(Args...)> {};
+
+template <typename C, typename R, typename... Args>
+struct MemberSignature<R (C::*)(Args...) const noexcept> : MemberSignature<R (C::*)(Args...)> {};
+
+/// Calls member function with arguments unpacked from machine words
+template <typename Impl, auto Member, typename Signature>
+struct Trampoline;
+
+template <typename Impl, auto Member, typename R, typename... Args>
+struct Trampoline<Impl, Member, R(Args...)> {
+	template <std::size_t... I>
+	static int invoke(Impl * self, const unsigned (&words)[4], std::index_sequence<I...>)
+	{
+		if constexpr (std::is_void_v<R>)
+		{
+			(self->*Member)(from_word<Args>(words[I])...);
+			return 0;
+		}
+		else
+		{
+			return static_cast<int>(to_word((self->*Member)(from_word<Args>(words[I])...)));
+		}
+	}
+
+	static int entry(void * service, unsigned arg0, unsigned arg1, unsigned arg2, unsigned arg3)
+	{
+		const unsigned words[4] = { arg0, arg1, arg2, arg3 };
+		return invoke(static_cast<Impl *>(service), words, std::index_sequence_for<Args...>{});
+	}
+};
+
+}
+
+/** Description of one interface method.
+ * @tparam Interface interface this method belongs to
+ * @tparam Index position of the method in interface vtable
+ * @tparam Signature prototype of the method, such as `int(uint32_t)`
+ */
+template <typename Interface, unsigned Index, typename Signature>
+struct Method;
+
+/** Base of any RPC service implementing interface.
+ * Holds address of vtable as the first member, which is what the kernel
+ * expects. Implementation must not be polymorphic in C++ sense.
+ * @tparam Interface interface implemented by the service
+ */
+template <typename Interface>
+class Service {
+public:
+	/** Bind service to vtable.
+	 * @param table vtable created by @ref cmrx::rpc::vtable()
+	 */
+	template <typename Table>
+	constexpr explicit Service(const Table & table) : vtable_(&table)
+	{
+		static_assert(std::is_same_v<typename Table::interface, Interface>, "VTable was generated for different interface!");
+	}
+
+private:
+	const void * vtable_;
+};
+
+template <typename Interface, unsigned Index, typename R, typename... Args>
+struct Method<Interface, Index, R(Args...)> : detail::Prototype<R(Args...)> {
+	using interface = Interface;
+	using signature = R(Args...);
+	static constexpr unsigned index = Index;
+
+	/** Perform the call.
+	 * Arguments are converted to parameter types of the method the same way
+	 * as if the method was called directly.
+	 */
+	static inline R call(const Service<Interface> * service, Args... args)
+	{
+		const unsigned words[4] = { detail::to_word(args)... };
+		int rv = _rpc_call(words[0], words[1], words[2], words[3],
+				const_cast<Service<Interface> *>(service), Index, 0xAA55AA55);
+		if constexpr (!std::is_void_v<R>)
+		{
+			return detail::from_word<R>(static_cast<unsigned>(rv));
+		}
+		else
+		{
+			(void) rv;
+		}
+	}
+};
+
+/** List of methods of interface in vtable order.
+ */
+template <typename... M>
+struct Methods {
+	static constexpr std::size_t size = sizeof...(M);
+
+	template <std::size_t N>
+	using at = std::tuple_element_t<N, std::tuple<M...>>;
+};
+
+/** Virtual method table of service.
+ * Layout matches C vtable, which is an array of function pointers.
+ */
+template <typename Interface, std::size_t N>
+struct VTable {
+	using interface = Interface;
+	detail::Entry entries[N];
+};
+
+namespace detail {
+
+/// Fill vtable entries with trampolines of member functions
+template <typename Interface, typename Impl, auto... Members, std::size_t... I>
+constexpr auto make_vtable(std::index_sequence<I...>)
+{
+	using List = typename Interface::methods;
+	static_assert(((List::template at<I>::index == I) && ...), "Interface methods must be listed in order of their indices!");
+	static_assert((std::is_same_v<typename MemberSignature<decltype(Members)>::type,
+			typename List::template at<I>::signature> && ...), "Member function prototype does not match interface method!");
+	return cmrx::rpc::VTable<Interface, sizeof...(Members)>{ {
+		&Trampoline<Impl, Members, typename List::template at<I>::signature>::entry...
+	} };
+}
+
+}
+
+/** Generate vtable binding member functions to interface methods.
+ * Amount of member functions and their prototypes are checked against the interface.
+ * Result shall be stored in `constexpr` variable marked with @ref CMRX_RPC_VTABLE.
+ * @tparam Interface interface being implemented
+ * @tparam Impl service class implementing the interface
+ * @tparam Members member functions of Impl, in order of interface methods
+ */
+template <typename Interface, typename Impl, auto... Members>
+constexpr VTable<Interface, sizeof...(Members)> vtable()
+{
+	using List = typename Interface::methods;
+	static_assert(sizeof...(Members) == List::size, "VTable has to bind every method of interface!");
+	static_assert(std::is_base_of_v<Service<Interface>, Impl>, "Service must derive from cmrx::rpc::Service<Interface>!");
+	static_assert(!std::is_polymorphic_v<Impl>, "Service must not have virtual methods, vtable address has to be its first member!");
+
+	return detail::make_vtable<Interface, Impl, Members...>(std::make_index_sequence<sizeof...(Members)>{});
+}
+
+/** Call method of service.
+ * @tparam M method being called, such as `Counter::add`
+ * @param service address of service implementing the interface method belongs to
+ * @param args method arguments
+ * @returns whatever value service returned
+ */
+template <typename M, typename S, typename... Args>
+inline auto call(S * service, Args &&... args)
+{
+	static_assert(std::is_base_of_v<Service<typename M::interface>, S>, "Service does not implement interface of this method!");
+	return M::call(service, std::forward<Args>(args)...);
+}
+
+}
+
+/** @} */
@@ -448,6 +448,10 @@ class LinkerFile(TokenList):
                         include_seq += self._gen_variable_assignment("__thread_create_start", [Token(FULLSTOP, ".")])
                         include_seq += self._gen_keep_deploy("*", [".thread_create"])
                         include_seq += self._gen_variable_assignment("__thread_create_end", [Token(FULLSTOP, ".")])
+                        include_seq += self._gen_comment("Restartable atomic sequences table")
+                        include_seq += self._gen_variable_assignment("__ras_table_start", [Token(FULLSTOP, ".")])
+                        include_seq += self._gen_keep_deploy("*", [".ras_table"])
+                        include_seq += self._gen_variable_assignment("__ras_table_end", [Token(FULLSTOP, ".")])
                         include_seq += self._gen_comment("RPC interface VTABLEs")
                         include_seq += self._gen_include("gen." + binary_name + ".vtable.ld")
 
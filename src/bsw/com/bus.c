@@ -0,0 +1,191 @@
+/** @addtogroup bsw_com_bus
+ * @{
+ */
+#include <cmrx/bsw/com/bus.h>
+#include <cmrx/atomic.h>
+#include <cmrx/defines.h>
+#include <string.h>
+
+#include <cmrx/rpc/implementation.h>
+
+IMPLEMENTATION_OF(struct ComSubscription, struct ComSourceVMT);
+
+/** Check if subscription holds data consumer did not read yet.
+ * @param subscription subscription checked
+ * @returns true if there is anything to read
+ */
+static bool com_subscription_pending(struct ComSubscription * subscription)
+{
+	if (subscription->ring != NULL)
+	{
+		return ring_count(subscription->ring) != 0;
+	}
+
+	uint32_t sequence = subscription->sequence;
+	return sequence != subscription->seen && (sequence & 1) == 0;
+}
+
+/** Read the most recent sample of latest value subscription.
+ * @param subscription subscription read
+ * @param data buffer for sample
+ * @returns size of sample or 0 if there is no new sample
+ */
+static int com_subscription_read_latest(struct ComSubscription * subscription, uint8_t * data)
+{
+	uint32_t sequence;
+
+	do {
+		sequence = subscription->sequence;
+		if (sequence == subscription->seen || (sequence & 1) != 0)
+		{
+			/* Sample being written is announced by its writer once complete */
+			return 0;
+		}
+
+		memcpy(data, subscription->sample, subscription->sample_size);
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	} while (subscription->sequence != sequence);
+
+	subscription->seen = sequence;
+	return subscription->sample_size;
+}
+
+/** Read whatever data is available in subscription.
+ * @param subscription subscription read
+ * @param data buffer for samples
+ * @param max_len size of buffer
+ * @returns amount of bytes read
+ */
+static int com_subscription_take(struct ComSubscription * subscription, uint8_t * data, unsigned max_len)
+{
+	if (subscription->ring != NULL)
+	{
+		return ring_pop(subscription->ring, data, max_len / subscription->sample_size) * subscription->sample_size;
+	}
+
+	return com_subscription_read_latest(subscription, data);
+}
+
+int com_subscription_read(INSTANCE(this), uint8_t * data, unsigned max_len)
+{
+	if (max_len < this->sample_size)
+	{
+		return 0;
+	}
+
+	int length = com_subscription_take(this, data, max_len);
+	if (length == 0)
+	{
+		/* Consumer has read everything, next sample notifies it again.
+		 * Sample published meanwhile might not have notified it, so look
+		 * once more after notification is rearmed.
+		 */
+		this->notified = 0;
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		length = com_subscription_take(this, data, max_len);
+	}
+
+	return length;
+}
+
+bool com_subscription_ready(INSTANCE(this))
+{
+	return com_subscription_pending(this);
+}
+
+void com_subscription_set_notify(INSTANCE(this), struct ComNotification * listener, uint32_t signal)
+{
+	this->listener = NULL;
+	this->signal = signal;
+	this->notified = 0;
+	this->listener = listener;
+}
+
+/** Store samples into subscription and notify its consumer.
+ * @param subscription subscription samples are delivered to
+ * @param data samples
+ * @param count amount of samples
+ */
+static void com_subscription_deliver(struct ComSubscription * subscription, const uint8_t * data, unsigned count)
+{
+	if (subscription->ring != NULL)
+	{
+		unsigned pushed = ring_push_multi(subscription->ring, data, count);
+		if (pushed < count)
+		{
+			atomic_add(&subscription->dropped, count - pushed);
+		}
+
+		if (pushed == 0)
+		{
+			return;
+		}
+	}
+	else
+	{
+		uint32_t sequence = subscription->sequence;
+		if ((sequence & 1) != 0 || !atomic_cas(&subscription->sequence, sequence, sequence + 1))
+		{
+			/* Another publisher got preempted while writing older sample.
+			 * It can't finish before we return, so this sample is lost.
+			 */
+			atomic_add(&subscription->dropped, 1);
+			return;
+		}
+
+		memcpy(subscription->sample, data + (count - 1) * subscription->sample_size, subscription->sample_size);
+		__atomic_thread_fence(__ATOMIC_RELEASE);
+		subscription->sequence = sequence + 2;
+	}
+
+	struct ComNotification * listener = subscription->listener;
+	if (listener != NULL && atomic_cas(&subscription->notified, 0, 1))
+	{
+		com_notify(listener, subscription->signal);
+	}
+}
+
+#include <cmrx/rpc/implementation.h>
+
+IMPLEMENTATION_OF(struct ComTopic, struct ComSinkVMT);
+
+int com_topic_write(INSTANCE(this), const uint8_t * data, unsigned length)
+{
+	if (length == 0 || length % this->sample_size != 0)
+	{
+		return E_WRONG_SIZE;
+	}
+
+	for (unsigned q = 0; q < this->subscription_count; ++q)
+	{
+		com_subscription_deliver(this->subscriptions[q], data, length / this->sample_size);
+	}
+
+	return E_OK;
+}
+
+bool com_topic_free(INSTANCE(this))
+{
+	(void) this;
+	/* Slow consumers lose samples, publisher is never blocked */
+	return true;
+}
+
+#include <cmrx/rpc/implementation.h>
+
+IMPLEMENTATION_OF(struct ComBus, struct ComBusVMT);
+
+int com_bus_publish(INSTANCE(this), const char * topic, const uint8_t * data, unsigned length)
+{
+	for (unsigned q = 0; q < this->topic_count; ++q)
+	{
+		if (strcmp(this->topics[q]->name, topic) == 0)
+		{
+			return com_topic_write(this->topics[q], data, length);
+		}
+	}
+
+	return E_NOTAVAIL;
+}
+
+/** @} */
@@ -0,0 +1,85 @@
+/** @ingroup api_atomic
+ * @{
+ */
+
+#include <cmrx/atomic.h>
+
+#ifdef __ARM_ARCH_7M__
+
+#include <arch/cortex.h>
+
+bool atomic_cas(volatile uint32_t * address, uint32_t expected, uint32_t desired)
+{
+	do {
+		if (__LDREXW(address) != expected)
+		{
+			__CLREX();
+			return false;
+		}
+	} while (__STREXW(desired, address) != 0);
+	return true;
+}
+
+uint32_t atomic_add(volatile uint32_t * address, uint32_t value)
+{
+	uint32_t old;
+	do {
+		old = __LDREXW(address);
+	} while (__STREXW(old + value, address) != 0);
+	return old;
+}
+
+#endif
+
+#ifdef __ARM_ARCH_6M__
+
+#include <arch/ras.h>
+
+/// @cond IGNORE
+__attribute__((naked))
+/// @endcond
+bool atomic_cas(volatile uint32_t * address, uint32_t expected, uint32_t desired)
+{
+	(void) address;
+	(void) expected;
+	(void) desired;
+	asm volatile(
+			".syntax unified\n\t"
+			"1:\n\t"
+			"LDR r3, [r0]\n\t"
+			"CMP r3, r1\n\t"
+			"BNE 3f\n\t"
+			"STR r2, [r0]\n\t"
+			"2:\n\t"
+			"MOVS r0, #1\n\t"
+			"BX lr\n\t"
+			"3:\n\t"
+			"MOVS r0, #0\n\t"
+			"BX lr\n\t"
+			RAS_REGISTER(1b, 2b)
+	);
+}
+
+/// @cond IGNORE
+__attribute__((naked))
+/// @endcond
+uint32_t atomic_add(volatile uint32_t * address, uint32_t value)
+{
+	(void) address;
+	(void) value;
+	asm volatile(
+			".syntax unified\n\t"
+			"1:\n\t"
+			"LDR r2, [r0]\n\t"
+			"ADDS r3, r2, r1\n\t"
+			"STR r3, [r0]\n\t"
+			"2:\n\t"
+			"MOVS r0, r2\n\t"
+			"BX lr\n\t"
+			RAS_REGISTER(1b, 2b)
+	);
+}
+
+#endif
+
+/** @} */
@@ -6,6 +6,9 @@
 #include <cmrx/ipc/thread.h>
 #include <arch/conditional.h>
 #include <cmrx/defines.h>
+#include <cmrx/atomic.h>
+#include <conf/kernel.h>
+#include <stdbool.h>
 
 #ifdef __ARM_ARCH_7M__
 
@@ -111,23 +114,104 @@ static inline int __futex_fast_unlock(futex_t * futex, uint8_t thread_id)
 
 #ifdef __ARM_ARCH_6M__
 
-#include <arch/sysenter.h>
+#include <arch/ras.h>
 
-__SYSCALL int __futex_fast_lock(futex_t * futex, uint8_t thread_id, unsigned max_depth)
+/* ARMv6-M has no exclusive access instructions. Fast paths are implemented
+ * as restartable atomic sequences instead. See @ref arch_arm_ras. Sequences
+ * must not modify their inputs, so scratch register is saved before the
+ * sequence starts.
+ */
+
+/** Lock futex.
+ * Restartable atomic sequence equivalent of LDREX-based futex lock.
+ * @param futex futex to be locked
+ * @param thread_id identification of calling thread
+ * @param max_depth maximum depth futex can already be locked in order to be still able to lock it
+ * @returns 0 if futex lock was successful, 1 if locking failed for whatever reason
+ */
+/// @cond IGNORE
+__attribute__((naked, noinline))
+/// @endcond
+static int __futex_fast_lock(futex_t * futex, uint8_t thread_id, unsigned max_depth)
 {
-    (void) futex;
-    (void) thread_id;
-    (void) max_depth;
-    /* TODO: Kernel doesn't support LDREX emulation */
-    return E_NOTAVAIL;
+	(void) futex;
+	(void) thread_id;
+	(void) max_depth;
+	asm volatile(
+			".syntax unified\n\t"
+			"PUSH { r4, lr }\n\t"
+			"1:\n\t"
+			// load mutex->state and mutex->owner values
+			"LDRB r3, [r0, #2]\n\t"
+			"LDRB r4, [r0, #0]\n\t"
+
+			// is mutex claimed?
+			"CMP r4, #0xFF\n\t"
+			"BEQ 3f\n\t" // .not_owned
+			// mutex is claimed by someone, by us?
+			"CMP r4, r1\n\t"
+			"BNE 4f\n\t" // .non_lockable
+
+			"3:\n\t" // .not_owned:
+			"CMP r3, r2\n\t"
+			"BGT 4f\n\t" // .non_lockable
+
+			// mutex is lockable, so lock it
+			"ADDS r3, #1\n\t"
+			"STRB r3, [r0, #2]\n\t"
+			"2:\n\t"
+			"MOVS r0, #0\n\t"
+			"POP { r4, pc }\n\t"
+
+			"4:\n\t" // .non_lockable:
+			"MOVS r0, #1\n\t"
+			"POP { r4, pc }\n\t"
+			RAS_REGISTER(1b, 2b)
+	);
 }
 
-__SYSCALL int __futex_fast_unlock(futex_t * futex, uint8_t thread_id)
+/** Unlock futex.
+ * Restartable atomic sequence equivalent of LDREX-based futex unlock.
+ * @param futex Futex to be unlocked
+ * @param thread_id Numeric identification of futex owner
+ * @returns 0 if futex unlock was successful, 1 if unlocking failed for
+ * whatever reason.
+ */
+/// @cond IGNORE
+__attribute__((naked, noinline))
+/// @endcond
+static int __futex_fast_unlock(futex_t * futex, uint8_t thread_id)
 {
-    (void) futex;
-    (void) thread_id;
-    /* TODO: Kernel doesn't support LDREX emulation */
-    return E_NOTAVAIL;
+	(void) futex;
+	(void) thread_id;
+	asm volatile(
+			".syntax unified\n\t"
+			"PUSH { r4, lr }\n\t"
+			"1:\n\t"
+			// load mutex->state and mutex->owner values
+			"LDRB r3, [r0, #2]\n\t"
+			"LDRB r4, [r0, #0]\n\t"
+
+			// check if mutex is suitable for unlocking (must be non-zero)
+			"CMP r3, #0\n\t"
+			"BEQ 4f\n\t" // .not_unlockable
+
+			// check if mutex is claimed by us currently
+			"CMP r4, r1\n\t"
+			"BNE 4f\n\t" // .not_unlockable
+
+			// mutex is unlockable, so unlock it
+			"SUBS r3, #1\n\t"
+			"STRB r3, [r0, #2]\n\t"
+			"2:\n\t"
+			"MOVS r0, #0\n\t"
+			"POP { r4, pc }\n\t"
+
+			"4:\n\t" // .not_unlockable:
+			"MOVS r0, #1\n\t"
+			"POP { r4, pc }\n\t"
+			RAS_REGISTER(1b, 2b)
+	);
 }
 
 #endif
@@ -238,43 +322,191 @@ int mutex_unlock(mutex_t * mutex)
 
 #endif
 
+#ifdef KERNEL_HAS_LOCK_PROFILE
+#define futex_profile(futex, event)		lock_profile((futex), (event))
+#else
+#define futex_profile(futex, event)
+#endif
+
+/** Access futex owner, flags, state and ceiling as single word.
+ * @param futex futex
+ * @returns address of futex word
+ */
+static inline volatile uint32_t * futex_word(futex_t * futex)
+{
+	return (volatile uint32_t *) futex;
+}
+
+/** Extract flags from futex word */
+#define FUTEX_WORD_FLAGS(word)	(((word) >> 8) & 0xFF)
+
+/** Extract state from futex word */
+#define FUTEX_WORD_STATE(word)	(((word) >> 16) & 0xFF)
+
+/** Atomically modify futex flags.
+ * @param futex futex
+ * @param set flags to be set
+ * @param clear flags to be cleared
+ * @returns value of flags before modification
+ */
+static uint8_t futex_update_flags(futex_t * futex, uint8_t set, uint8_t clear)
+{
+	uint32_t word;
+	do {
+		word = *futex_word(futex);
+	} while (!atomic_cas(futex_word(futex), word, (word & ~(clear << 8)) | (set << 8)));
+	return FUTEX_WORD_FLAGS(word);
+}
+
+/** Lock futex, sleeping in kernel while it is locked by someone else.
+ * @param futex futex to be locked
+ * @param thread_id identification of calling thread
+ * @param waited true if caller already slept on this futex. Unlock wakes
+ * one thread only and clears FUTEX_WAITERS flag, so thread which slept
+ * can't tell if others still sleep. It sets the flag again once it owns
+ * the futex.
+ */
+static void futex_lock_contended(futex_t * futex, uint8_t thread_id, bool waited)
+{
+	while (__futex_fast_lock(futex, thread_id, 0) != 0)
+	{
+		uint32_t word = *futex_word(futex);
+		if (FUTEX_WORD_STATE(word) == 0)
+		{
+			/* Unlocked meanwhile, retry */
+			continue;
+		}
+
+		uint32_t sleeping = word | (FUTEX_WAITERS << 8);
+		if (word != sleeping && !atomic_cas(futex_word(futex), word, sleeping))
+		{
+			continue;
+		}
+
+		/* Returns immediately if futex changed after flag was set */
+		futex_wait((uint32_t *) futex_word(futex), sleeping, WAIT_FOREVER);
+		waited = true;
+	}
+	futex->owner = thread_id;
+
+	if (waited)
+	{
+		futex_update_flags(futex, FUTEX_WAITERS, 0);
+	}
+}
+
+/** Lock futex, honoring its priority ceiling.
+ * @param futex futex to be locked
+ * @param waited see @ref futex_lock_contended()
+ */
+static void futex_lock_ceiling(futex_t * futex, bool waited)
+{
+	uint8_t thread_id = get_tid();
+	int priority = 0;
+
+	/* Raise priority before lock is taken, so that owner can't
+	 * be preempted by other user of futex while holding it.
+	 */
+	if (futex->flags & FUTEX_PRIORITY_CEILING)
+	{
+		priority = priority_ceiling(futex->ceiling);
+	}
+
+	futex_lock_contended(futex, thread_id, waited);
+	futex->saved_priority = priority;
+	futex_profile(futex, LOCK_PROFILE_ACQUIRED);
+}
+
 int futex_init(futex_t * restrict futex)
 {
 	futex->owner = 0xFF;
 	futex->state = 0;
 	futex->flags = 0;
+	futex->ceiling = 0;
+	futex->saved_priority = 0;
+	return 0;
+}
+
+int futex_init_ceiling(futex_t * restrict futex, uint8_t ceiling)
+{
+	futex_init(futex);
+	futex->ceiling = ceiling;
+	futex->flags = FUTEX_PRIORITY_CEILING;
 	return 0;
 }
 
 int futex_lock(futex_t * futex)
 {
-	uint8_t thread_id = get_tid();
-	int success;
-	do {
-		success = __futex_fast_lock(futex, thread_id, 0);
-		if (success != 0)
-		{
-			sched_yield();
-		}
-	} while (success != 0);
-	futex->owner = thread_id;
+	futex_lock_ceiling(futex, false);
 	return 0;
 }
 
+int __futex_lock_woken(futex_t * futex)
+{
+	futex_lock_ceiling(futex, true);
+	return 0;
+}
+
+void __futex_set_waiters(futex_t * futex)
+{
+	futex_update_flags(futex, FUTEX_WAITERS, 0);
+}
+
 int futex_trylock(futex_t * futex)
 {
 	uint8_t thread_id = get_tid();
+	int priority = 0;
+
+	if (futex->flags & FUTEX_PRIORITY_CEILING)
+	{
+		priority = priority_ceiling(futex->ceiling);
+	}
+
 	int success = __futex_fast_lock(futex, thread_id, 0);
+	if (success == 0)
+	{
+		futex->owner = thread_id;
+		futex->saved_priority = priority;
+		futex_profile(futex, LOCK_PROFILE_ACQUIRED);
+	}
+	else if (futex->flags & FUTEX_PRIORITY_CEILING)
+	{
+		setpriority(priority);
+	}
 	return success;
 }
 
 int futex_unlock(futex_t * futex)
 {
 	uint8_t thread_id = get_tid();
+	/* Futex may be locked by someone else right after it is unlocked */
+	uint8_t priority = futex->saved_priority;
+
+	/* Reported while still held, so that next owner can't be recorded first */
+	if (futex->owner == thread_id && futex->state != 0)
+	{
+		futex_profile(futex, LOCK_PROFILE_RELEASED);
+	}
+
 	int success = __futex_fast_unlock(futex, thread_id);
-	if (success == 0 && futex->state == 0)
+	if (success == 0)
 	{
-		futex->owner = 0xFF;
+		if (futex->state == 0)
+		{
+			futex->owner = 0xFF;
+		}
+
+		/* Kernel is only entered if someone sleeps on futex */
+		if ((FUTEX_WORD_FLAGS(*futex_word(futex)) & FUTEX_WAITERS)
+				&& (futex_update_flags(futex, 0, FUTEX_WAITERS) & FUTEX_WAITERS))
+		{
+			futex_wake((uint32_t *) futex_word(futex), 1);
+		}
+
+		if (futex->flags & FUTEX_PRIORITY_CEILING)
+		{
+			setpriority(priority);
+		}
 	}
 	return success;
 }
@@ -0,0 +1,48 @@
+/** @ingroup api_rpc
+ * @{
+ */
+
+#include <cmrx/ipc/rpc.h>
+#include <cmrx/os/syscalls.h>
+#include <arch/sysenter.h>
+
+/* Timed RPC call may be aborted at any point inside the callee. Kernel then
+ * returns directly into this stub, so callee-saved registers of the caller
+ * are stored here, rather than relying on the callee to restore them. Kernel
+ * expects exactly 8 registers to be stored before arguments passed on stack.
+ */
+__attribute__((naked)) __attribute__((noinline)) int _rpc_call_timed(unsigned arg0, unsigned arg1, unsigned arg2, unsigned arg3, void * service, unsigned method, unsigned timeout)
+{
+    (void) arg0;
+    (void) arg1;
+    (void) arg2;
+    (void) arg3;
+    (void) service;
+    (void) method;
+    (void) timeout;
+	asm volatile(
+			".syntax unified\n\t"
+#ifdef __ARM_ARCH_6M__
+			"PUSH {r4 - r7}\n\t"
+			"MOV r4, r8\n\t"
+			"MOV r5, r9\n\t"
+			"MOV r6, r10\n\t"
+			"MOV r7, r11\n\t"
+			"PUSH {r4 - r7}\n\t"
+			"SVC %[immediate]\n\t"
+			"POP {r4 - r7}\n\t"
+			"MOV r8, r4\n\t"
+			"MOV r9, r5\n\t"
+			"MOV r10, r6\n\t"
+			"MOV r11, r7\n\t"
+			"POP {r4 - r7}\n\t"
+#else
+			"PUSH {r4 - r11}\n\t"
+			"SVC %[immediate]\n\t"
+			"POP {r4 - r11}\n\t"
+#endif
+			"BX LR\n\t" : : [immediate] "I" (SYSCALL_RPC_CALL_TIMED)
+	);
+}
+
+/** @} */
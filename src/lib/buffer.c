@@ -0,0 +1,31 @@
+/** @ingroup api_buffer
+ * @{
+ */
+#include <cmrx/ipc/buffer.h>
+#include <cmrx/os/syscalls.h>
+
+__SYSCALL int buffer_alloc(void)
+{
+	__SVC(SYSCALL_BUFFER_ALLOC);
+}
+
+__SYSCALL void * buffer_address(int buffer)
+{
+    (void) buffer;
+	__SVC(SYSCALL_BUFFER_ADDRESS);
+}
+
+__SYSCALL int buffer_send(int buffer, Thread_t thread)
+{
+    (void) buffer;
+    (void) thread;
+	__SVC(SYSCALL_BUFFER_SEND);
+}
+
+__SYSCALL int buffer_free(int buffer)
+{
+    (void) buffer;
+	__SVC(SYSCALL_BUFFER_FREE);
+}
+
+/** @} */
@@ -0,0 +1,58 @@
+/** @ingroup api_cond
+ * @{
+ */
+#include <cmrx/ipc/cond.h>
+#include <cmrx/atomic.h>
+
+int cond_init(cond_t * cond)
+{
+	cond->sequence = 0;
+	cond->futex = NULL;
+	return 0;
+}
+
+int cond_wait(cond_t * cond, futex_t * futex, unsigned timeout_us)
+{
+	/* Sampled before futex is unlocked, so signal sent by anyone after
+	 * that changes the sequence and futex_wait() won't sleep.
+	 */
+	uint32_t sequence = cond->sequence;
+	cond->futex = futex;
+
+	futex_unlock(futex);
+	int rv = futex_wait(&cond->sequence, sequence, timeout_us);
+
+	/* Thread might have been moved onto the futex by broadcast */
+	__futex_lock_woken(futex);
+
+	return rv == E_TIMEOUT ? E_TIMEOUT : E_OK;
+}
+
+int cond_signal(cond_t * cond)
+{
+	atomic_add(&cond->sequence, 1);
+	futex_wake(&cond->sequence, 1);
+	return 0;
+}
+
+int cond_broadcast(cond_t * cond)
+{
+	atomic_add(&cond->sequence, 1);
+
+	futex_t * futex = cond->futex;
+	if (futex == NULL)
+	{
+		/* Nobody ever waited */
+		return 0;
+	}
+
+	/* Threads moved to futex are woken by its unlock, which only enters
+	 * kernel if the futex has waiters flagged. Woken waiter keeps the flag
+	 * set until all moved threads are woken.
+	 */
+	__futex_set_waiters(futex);
+	futex_requeue(&cond->sequence, 1, (uint32_t *) futex);
+	return 0;
+}
+
+/** @} */
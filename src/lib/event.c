@@ -0,0 +1,41 @@
+/** @ingroup api_event
+ * @{
+ */
+#include <cmrx/ipc/event.h>
+#include <cmrx/os/syscalls.h>
+
+__SYSCALL int event_group_create(void)
+{
+	__SVC(SYSCALL_EVENT_GROUP_CREATE);
+}
+
+__SYSCALL int event_group_delete(int group)
+{
+    (void) group;
+	__SVC(SYSCALL_EVENT_GROUP_DELETE);
+}
+
+__SYSCALL int event_group_set(int group, uint32_t bits)
+{
+    (void) group;
+    (void) bits;
+	__SVC(SYSCALL_EVENT_GROUP_SET);
+}
+
+__SYSCALL int event_group_clear(int group, uint32_t bits)
+{
+    (void) group;
+    (void) bits;
+	__SVC(SYSCALL_EVENT_GROUP_CLEAR);
+}
+
+__SYSCALL int event_group_wait(int group, uint32_t * bits, unsigned flags, unsigned timeout_us)
+{
+    (void) group;
+    (void) bits;
+    (void) flags;
+    (void) timeout_us;
+	__SVC(SYSCALL_EVENT_GROUP_WAIT);
+}
+
+/** @} */
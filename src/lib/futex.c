@@ -0,0 +1,37 @@
+/** @ingroup api_mutex
+ * @{
+ */
+#include <cmrx/ipc/mutex.h>
+#include <cmrx/os/syscalls.h>
+
+__SYSCALL int futex_wait(uint32_t * address, uint32_t expected, unsigned timeout_us)
+{
+    (void) address;
+    (void) expected;
+    (void) timeout_us;
+	__SVC(SYSCALL_FUTEX_WAIT);
+}
+
+__SYSCALL int futex_wake(uint32_t * address, unsigned count)
+{
+    (void) address;
+    (void) count;
+	__SVC(SYSCALL_FUTEX_WAKE);
+}
+
+__SYSCALL int futex_requeue(uint32_t * address, unsigned count, uint32_t * target)
+{
+    (void) address;
+    (void) count;
+    (void) target;
+	__SVC(SYSCALL_FUTEX_REQUEUE);
+}
+
+__SYSCALL int lock_profile(const void * lock, unsigned event)
+{
+    (void) lock;
+    (void) event;
+	__SVC(SYSCALL_LOCK_PROFILE);
+}
+
+/** @} */
@@ -0,0 +1,49 @@
+/** @ingroup api_mqueue
+ * @{
+ */
+#include <cmrx/ipc/mqueue.h>
+#include <cmrx/os/syscalls.h>
+
+__SYSCALL int mqueue_create(unsigned depth, unsigned message_size)
+{
+    (void) depth;
+    (void) message_size;
+	__SVC(SYSCALL_MQUEUE_CREATE);
+}
+
+__SYSCALL int mqueue_delete(int queue)
+{
+    (void) queue;
+	__SVC(SYSCALL_MQUEUE_DELETE);
+}
+
+__SYSCALL int mqueue_send(int queue, const void * message, unsigned timeout_us)
+{
+    (void) queue;
+    (void) message;
+    (void) timeout_us;
+	__SVC(SYSCALL_MQUEUE_SEND);
+}
+
+__SYSCALL int mqueue_receive(int queue, void * message, unsigned timeout_us)
+{
+    (void) queue;
+    (void) message;
+    (void) timeout_us;
+	__SVC(SYSCALL_MQUEUE_RECEIVE);
+}
+
+__SYSCALL int mqueue_receive_map(int queue, const void ** message, unsigned timeout_us)
+{
+    (void) queue;
+    (void) message;
+    (void) timeout_us;
+	__SVC(SYSCALL_MQUEUE_RECEIVE_MAP);
+}
+
+__SYSCALL int mqueue_release(void)
+{
+	__SVC(SYSCALL_MQUEUE_RELEASE);
+}
+
+/** @} */
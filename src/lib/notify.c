@@ -0,0 +1,22 @@
+/** @ingroup api_notify
+ * @{
+ */
+#include <cmrx/ipc/notify.h>
+#include <cmrx/os/syscalls.h>
+
+__SYSCALL int notify_give(Thread_t thread, unsigned index)
+{
+    (void) thread;
+    (void) index;
+	__SVC(SYSCALL_NOTIFY_GIVE);
+}
+
+__SYSCALL int notify_take(unsigned index, bool clear, unsigned timeout_us)
+{
+    (void) index;
+    (void) clear;
+    (void) timeout_us;
+	__SVC(SYSCALL_NOTIFY_TAKE);
+}
+
+/** @} */
@@ -0,0 +1,207 @@
+/** @ingroup api_ring
+ * @{
+ */
+#include <cmrx/ipc/ring.h>
+#include <cmrx/ipc/mutex.h>
+#include <cmrx/ipc/signal.h>
+#include <cmrx/atomic.h>
+#include <string.h>
+
+/** Wake all threads sleeping on futex word */
+#define RING_WAKE_ALL			0xFF
+
+int ring_init(ring_t * ring, void * storage, unsigned item_size, unsigned capacity)
+{
+	if (capacity == 0 || (capacity & (capacity - 1)) != 0)
+	{
+		return E_INVALID;
+	}
+
+	ring->head = 0;
+	ring->reserve = 0;
+	ring->tail = 0;
+	ring->buffer = storage;
+	ring->item_size = item_size;
+	ring->consumer = 0;
+	ring->signal = RING_NO_SIGNAL;
+	ring->capacity = capacity;
+	return E_OK;
+}
+
+int ring_set_signal(ring_t * ring, Thread_t consumer, unsigned signal)
+{
+	if (signal >= 32 && signal != RING_NO_SIGNAL)
+	{
+		return E_INVALID;
+	}
+
+	ring->consumer = consumer;
+	ring->signal = signal;
+	return E_OK;
+}
+
+/** Copy items into or out of storage, handling wrap around.
+ * @param ring ring buffer
+ * @param index index of first item
+ * @param items items outside of ring
+ * @param count amount of items
+ * @param into true to copy into storage, false to copy out of it
+ */
+static void ring_copy(ring_t * ring, uint32_t index, uint8_t * items, unsigned count, bool into)
+{
+	unsigned position = index & (ring->capacity - 1);
+	unsigned first = ring->capacity - position;
+	if (first > count)
+	{
+		first = count;
+	}
+
+	uint8_t * storage = ring->buffer + position * ring->item_size;
+	unsigned first_size = first * ring->item_size;
+	unsigned rest_size = (count - first) * ring->item_size;
+
+	if (into)
+	{
+		memcpy(storage, items, first_size);
+		memcpy(ring->buffer, items + first_size, rest_size);
+	}
+	else
+	{
+		memcpy(items, storage, first_size);
+		memcpy(items + first_size, ring->buffer, rest_size);
+	}
+}
+
+/** Make items visible to consumer.
+ * Consumer is woken up if ring was empty before.
+ * @param ring ring buffer
+ * @param start index of first item being published
+ * @param end index one past last item being published
+ * @param waiting true if other producers may wait for these items to be published
+ */
+static void ring_publish(ring_t * ring, uint32_t start, uint32_t end, bool waiting)
+{
+	/* Items have to be stored before they are published */
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	ring->head = end;
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	bool was_empty = ring->tail == start;
+
+	if (was_empty && ring->signal != RING_NO_SIGNAL)
+	{
+		kill(ring->consumer, ring->signal);
+	}
+
+	if ((was_empty && ring->signal == RING_NO_SIGNAL) || waiting)
+	{
+		futex_wake((uint32_t *) &ring->head, RING_WAKE_ALL);
+	}
+}
+
+unsigned ring_push(ring_t * ring, const void * items, unsigned count)
+{
+	uint32_t head = ring->head;
+	uint32_t free = ring->capacity - (head - ring->tail);
+	if (count > free)
+	{
+		count = free;
+	}
+
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	/* Space must not be reused before consumer finished reading it */
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	ring_copy(ring, head, (uint8_t *) items, count, true);
+	ring->reserve = head + count;
+	ring_publish(ring, head, head + count, false);
+	return count;
+}
+
+unsigned ring_push_multi(ring_t * ring, const void * items, unsigned count)
+{
+	uint32_t start;
+	unsigned reserved;
+
+	do {
+		start = ring->reserve;
+		uint32_t free = ring->capacity - (start - ring->tail);
+		reserved = count > free ? free : count;
+		if (reserved == 0)
+		{
+			return 0;
+		}
+	} while (!atomic_cas(&ring->reserve, start, start + reserved));
+
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	ring_copy(ring, start, (uint8_t *) items, reserved, true);
+
+	/* Items are published in order of reservation. Producer which reserved
+	 * space earlier may have lower priority, so sleep instead of spinning.
+	 */
+	uint32_t head;
+	while ((head = ring->head) != start)
+	{
+		futex_wait((uint32_t *) &ring->head, head, WAIT_FOREVER);
+	}
+
+	ring_publish(ring, start, start + reserved, ring->reserve != start + reserved);
+	return reserved;
+}
+
+unsigned ring_pop(ring_t * ring, void * items, unsigned count)
+{
+	uint32_t tail = ring->tail;
+	uint32_t available = ring->head - tail;
+	if (count > available)
+	{
+		count = available;
+	}
+
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	/* Items must not be read before they are published */
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	ring_copy(ring, tail, items, count, false);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	ring->tail = tail + count;
+	return count;
+}
+
+unsigned ring_pop_wait(ring_t * ring, void * items, unsigned count, unsigned timeout_us)
+{
+	while (true)
+	{
+		unsigned popped = ring_pop(ring, items, count);
+		if (popped != 0 || count == 0)
+		{
+			return popped;
+		}
+
+		if (ring->signal != RING_NO_SIGNAL)
+		{
+			/* Signal may be pending from items popped already */
+			if (sigwait(1 << ring->signal, timeout_us) == 0)
+			{
+				return 0;
+			}
+		}
+		else if (futex_wait((uint32_t *) &ring->head, ring->tail, timeout_us) == E_TIMEOUT)
+		{
+			return 0;
+		}
+	}
+}
+
+unsigned ring_count(const ring_t * ring)
+{
+	return ring->head - ring->tail;
+}
+
+/** @} */
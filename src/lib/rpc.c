@@ -19,4 +19,78 @@ __SYSCALL int _rpc_call(unsigned arg0, unsigned arg1, unsigned arg2, unsigned ar
 	__SVC(SYSCALL_RPC_CALL);
 }
 
+__SYSCALL int _rpc_call_async(unsigned arg0, unsigned arg1, unsigned arg2, unsigned arg3, void * service, unsigned method, unsigned signal)
+{
+    (void) arg0;
+    (void) arg1;
+    (void) arg2;
+    (void) arg3;
+    (void) service;
+    (void) method;
+    (void) signal;
+	__SVC(SYSCALL_RPC_CALL_ASYNC);
+}
+
+__SYSCALL int _rpc_call_queued(unsigned arg0, unsigned arg1, unsigned arg2, unsigned arg3, void * service, unsigned method, unsigned canary)
+{
+    (void) arg0;
+    (void) arg1;
+    (void) arg2;
+    (void) arg3;
+    (void) service;
+    (void) method;
+    (void) canary;
+	__SVC(SYSCALL_RPC_CALL_QUEUED);
+}
+
+__SYSCALL int rpc_cancel_notify(Thread_t thread_id, uint32_t signal)
+{
+    (void) thread_id;
+    (void) signal;
+	__SVC(SYSCALL_RPC_CANCEL_NOTIFY);
+}
+
+__SYSCALL int rpc_serve()
+{
+	__SVC(SYSCALL_RPC_SERVE);
+}
+
+__SYSCALL int _rpc_poll(int token)
+{
+    (void) token;
+	__SVC(SYSCALL_RPC_POLL);
+}
+
+__SYSCALL int _rpc_result(int token)
+{
+    (void) token;
+	__SVC(SYSCALL_RPC_RESULT);
+}
+
+int rpc_poll(int token, int * retval)
+{
+	int rv = _rpc_poll(token);
+	if (rv == E_OK)
+	{
+		int value = _rpc_result(token);
+		if (retval != NULL)
+		{
+			*retval = value;
+		}
+	}
+	return rv;
+}
+
+int rpc_worker(void * data)
+{
+    (void) data;
+
+    while (1)
+    {
+        rpc_serve();
+    }
+
+    return 0;
+}
+
 /** @} */
@@ -0,0 +1,174 @@
+/** @ingroup api_rwlock
+ * @{
+ */
+#include <cmrx/ipc/rwlock.h>
+#include <cmrx/ipc/mutex.h>
+#include <cmrx/atomic.h>
+#include <cmrx/defines.h>
+
+/** Mask of amount of readers holding the lock */
+#define RWLOCK_READERS			0x0000FFFF
+
+/** Lock is held by writer */
+#define RWLOCK_WRITER			0x00010000
+
+/** Some readers sleep on state word */
+#define RWLOCK_READERS_WAITING	0x00020000
+
+/** One writer waiting for the lock */
+#define RWLOCK_WRITER_WAITING	0x01000000
+
+/** Mask of amount of writers waiting for the lock */
+#define RWLOCK_WRITERS_WAITING	0xFF000000
+
+/** Hand lock over to one waiting writer.
+ * @param lock lock
+ */
+static void rwlock_wake_writer(rwlock_t * lock)
+{
+	atomic_add(&lock->writer_sequence, 1);
+	futex_wake(&lock->writer_sequence, 1);
+}
+
+int rwlock_init(rwlock_t * lock)
+{
+	lock->state = 0;
+	lock->writer_sequence = 0;
+	return 0;
+}
+
+int rwlock_read_trylock(rwlock_t * lock)
+{
+	uint32_t state;
+	do {
+		state = lock->state;
+		if (state & (RWLOCK_WRITER | RWLOCK_WRITERS_WAITING))
+		{
+			return E_BUSY;
+		}
+	} while (!atomic_cas(&lock->state, state, state + 1));
+
+	return 0;
+}
+
+int rwlock_read_lock(rwlock_t * lock)
+{
+	while (true)
+	{
+		uint32_t state = lock->state;
+		if ((state & (RWLOCK_WRITER | RWLOCK_WRITERS_WAITING)) == 0)
+		{
+			if (atomic_cas(&lock->state, state, state + 1))
+			{
+				return 0;
+			}
+			continue;
+		}
+
+		uint32_t sleeping = state | RWLOCK_READERS_WAITING;
+		if (state != sleeping && !atomic_cas(&lock->state, state, sleeping))
+		{
+			continue;
+		}
+
+		/* Returns immediately if state changed after flag was set */
+		int rv = futex_wait(&lock->state, sleeping, WAIT_FOREVER);
+		if (rv != E_OK && rv != E_BUSY)
+		{
+			return rv;
+		}
+	}
+}
+
+int rwlock_read_unlock(rwlock_t * lock)
+{
+	uint32_t state = atomic_add(&lock->state, -1);
+
+	if ((state & RWLOCK_READERS) == 1 && (state & RWLOCK_WRITERS_WAITING) != 0)
+	{
+		/* Last reader gone, writers go first */
+		rwlock_wake_writer(lock);
+	}
+
+	return 0;
+}
+
+int rwlock_write_trylock(rwlock_t * lock)
+{
+	uint32_t state;
+	do {
+		state = lock->state;
+		if (state & (RWLOCK_READERS | RWLOCK_WRITER))
+		{
+			return E_BUSY;
+		}
+	} while (!atomic_cas(&lock->state, state, state | RWLOCK_WRITER));
+
+	return 0;
+}
+
+int rwlock_write_lock(rwlock_t * lock)
+{
+	/* Announce ourselves so that new readers are held off */
+	atomic_add(&lock->state, RWLOCK_WRITER_WAITING);
+
+	while (true)
+	{
+		/* Sampled before state, so that wakeup sent after state is
+		 * examined makes futex_wait() return immediately.
+		 */
+		uint32_t sequence = lock->writer_sequence;
+		uint32_t state = lock->state;
+
+		if ((state & (RWLOCK_READERS | RWLOCK_WRITER)) == 0)
+		{
+			if (atomic_cas(&lock->state, state, (state | RWLOCK_WRITER) - RWLOCK_WRITER_WAITING))
+			{
+				return 0;
+			}
+			continue;
+		}
+
+		int rv = futex_wait(&lock->writer_sequence, sequence, WAIT_FOREVER);
+		if (rv != E_OK && rv != E_BUSY)
+		{
+			/* Withdraw, readers might have been held off only by us */
+			state = atomic_add(&lock->state, -RWLOCK_WRITER_WAITING) - RWLOCK_WRITER_WAITING;
+			if ((state & (RWLOCK_WRITER | RWLOCK_WRITERS_WAITING)) == 0
+					&& (state & RWLOCK_READERS_WAITING) != 0)
+			{
+				futex_wake(&lock->state, ~0U);
+			}
+			return rv;
+		}
+	}
+}
+
+int rwlock_write_unlock(rwlock_t * lock)
+{
+	uint32_t state;
+	uint32_t unlocked;
+
+	do {
+		state = lock->state;
+		unlocked = state & ~RWLOCK_WRITER;
+		if ((unlocked & RWLOCK_WRITERS_WAITING) == 0)
+		{
+			/* Readers are going to be woken up */
+			unlocked &= ~RWLOCK_READERS_WAITING;
+		}
+	} while (!atomic_cas(&lock->state, state, unlocked));
+
+	if (unlocked & RWLOCK_WRITERS_WAITING)
+	{
+		rwlock_wake_writer(lock);
+	}
+	else if (state & RWLOCK_READERS_WAITING)
+	{
+		futex_wake(&lock->state, ~0U);
+	}
+
+	return 0;
+}
+
+/** @} */
@@ -0,0 +1,65 @@
+/** @ingroup api_sem
+ * @{
+ */
+#include <cmrx/ipc/sem.h>
+#include <cmrx/ipc/mutex.h>
+#include <cmrx/atomic.h>
+#include <cmrx/defines.h>
+#include <stdbool.h>
+
+int sem_init(sem_t * sem, uint32_t count)
+{
+	sem->value = count & SEM_COUNT;
+	return 0;
+}
+
+int sem_take(sem_t * sem, unsigned timeout_us)
+{
+	while (true)
+	{
+		uint32_t value = sem->value;
+		if ((value & SEM_COUNT) != 0)
+		{
+			if (atomic_cas(&sem->value, value, value - 1))
+			{
+				return E_OK;
+			}
+			continue;
+		}
+
+		if (timeout_us == 0)
+		{
+			return E_TIMEOUT;
+		}
+
+		uint32_t sleeping = value | SEM_WAITERS;
+		if (value != sleeping && !atomic_cas(&sem->value, value, sleeping))
+		{
+			continue;
+		}
+
+		/* Returns immediately if unit was given after flag was set */
+		int rv = futex_wait(&sem->value, sleeping, timeout_us);
+		if (rv != E_OK && rv != E_BUSY)
+		{
+			return rv;
+		}
+	}
+}
+
+int sem_give(sem_t * sem)
+{
+	uint32_t value = atomic_add(&sem->value, 1) + 1;
+
+	if ((value & SEM_WAITERS) != 0 && futex_wake(&sem->value, 1) == 0)
+	{
+		/* Nobody sleeps anymore. Flag is only cleared if nobody took
+		 * the unit meanwhile, which is the only way to start sleeping.
+		 */
+		atomic_cas(&sem->value, value, value & ~SEM_WAITERS);
+	}
+
+	return E_OK;
+}
+
+/** @} */
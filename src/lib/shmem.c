@@ -0,0 +1,22 @@
+/** @ingroup api_shared
+ * @{
+ */
+#include <cmrx/ipc/shmem.h>
+#include <cmrx/os/syscalls.h>
+
+__SYSCALL int shmem_window_open(const struct OS_process_definition_t * peer, void * base, unsigned size, unsigned flags)
+{
+    (void) peer;
+    (void) base;
+    (void) size;
+    (void) flags;
+	__SVC(SYSCALL_SHMEM_WINDOW_OPEN);
+}
+
+__SYSCALL int shmem_window_close(int window)
+{
+    (void) window;
+	__SVC(SYSCALL_SHMEM_WINDOW_CLOSE);
+}
+
+/** @} */
@@ -4,7 +4,7 @@
 #include <cmrx/ipc/signal.h>
 #include <cmrx/os/syscalls.h>
 
-__SYSCALL int signal(int signo, void (*sighandler)(uint32_t))
+__SYSCALL int signal(int signo, void (*sighandler)(uint32_t, uint32_t))
 {
     (void) signo;
     (void) sighandler;
@@ -18,4 +18,19 @@ __SYSCALL int kill(int thread, uint32_t signal)
 	__SVC(SYSCALL_KILL);
 }
 
+__SYSCALL int sigqueue(int thread, uint32_t signal, uint32_t value)
+{
+    (void) thread;
+    (void) signal;
+    (void) value;
+	__SVC(SYSCALL_SIGQUEUE);
+}
+
+__SYSCALL int sigwait(uint32_t mask, unsigned timeout_us)
+{
+    (void) mask;
+    (void) timeout_us;
+	__SVC(SYSCALL_SIGWAIT);
+}
+
 /** @} */
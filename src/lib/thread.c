@@ -42,6 +42,12 @@ __SYSCALL int setpriority(uint8_t priority)
 	__SVC(SYSCALL_SETPRIORITY);
 }
 
+__SYSCALL int priority_ceiling(uint8_t ceiling)
+{
+    (void) ceiling;
+	__SVC(SYSCALL_PRIORITY_CEILING);
+}
+
 /** Internal function, which disposes of thread which called it.
  *
  * This function is injected into stack (value of LR of thread entrypoint)
@@ -0,0 +1,15 @@
+/** @ingroup api_wait
+ * @{
+ */
+#include <cmrx/ipc/wait.h>
+#include <cmrx/os/syscalls.h>
+
+__SYSCALL int wait_objects(const struct WaitObject * objects, unsigned count, unsigned timeout_us)
+{
+    (void) objects;
+    (void) count;
+    (void) timeout_us;
+	__SVC(SYSCALL_WAIT_OBJECTS);
+}
+
+/** @} */
@@ -1,4 +1,5 @@
 #include <cmrx/os/mpu.h>
+#include <cmrx/os/arch/mpu.h>
 #include <cmrx/defines.h>
 #include <arch/mpu_priv.h>
 #include <conf/kernel.h>
@@ -315,6 +316,77 @@ void os_memory_protection_start()
 	mpu_enable();
 }
 
+/** Load window into MPU region.
+ * @param region region window is loaded into
+ * @param window window to be loaded
+ * @returns E_OK if window was loaded, error code if MPU can't map it
+ */
+static int mpu_load_window_region(uint8_t region, const struct OS_MPU_window_t * window)
+{
+	uint32_t RBAR, RASR;
+	int rv;
+
+	if (window->base == NULL || window->subregions == 0)
+	{
+		return mpu_clear_region(region);
+	}
+
+	if ((rv = mpu_configure_region(region, window->base, window->size, window->flags, &RBAR, &RASR)) == E_OK)
+	{
+		/* Disable subregions which are not part of the window */
+		RASR &= ~MPU_RASR_SRD;
+		RASR |= (((uint32_t) (uint8_t) ~window->subregions) << MPU_RASR_SRD_LSB) & MPU_RASR_SRD;
+
+		__ISB();
+		__DSB();
+		MPU_RBAR = RBAR;
+		MPU_RASR = RASR;
+		__ISB();
+		__DSB();
+	}
+	return rv;
+}
+
+int mpu_load_window(const struct OS_MPU_window_t * window)
+{
+	return mpu_load_window_region(OS_MPU_REGION_WINDOW, window);
+}
+
+int mpu_load_buffer_view(const struct OS_MPU_window_t * view)
+{
+	return mpu_load_window_region(OS_MPU_REGION_BUFFERS, view);
+}
+
+int mpu_set_shared_window(MPU_State * state, const void * base, uint32_t size, uint8_t flags)
+{
+	struct MPU_Registers * region = &(*state)[OS_MPU_REGION_MMIO2];
+
+	if (base == NULL)
+	{
+		return mpu_configure_region(OS_MPU_REGION_MMIO2, NULL, 0, MPU_NONE, &region->_MPU_RBAR, &region->_MPU_RASR);
+	}
+
+	if ((region->_MPU_RASR & MPU_RASR_ENABLE) != 0)
+	{
+		return E_BUSY;
+	}
+
+#ifdef __ARM_ARCH_6M__
+	/* ARMv6-M MPU does not support regions smaller than 256 bytes */
+	if (size < 256)
+	{
+		return E_MISALIGNED;
+	}
+#endif
+
+	return mpu_configure_region(OS_MPU_REGION_MMIO2, base, size, flags, &region->_MPU_RBAR, &region->_MPU_RASR);
+}
+
+int mpu_load_shared_window(const MPU_State * state)
+{
+	return mpu_load(state, OS_MPU_REGION_MMIO2, 1);
+}
+
 int mpu_init_stack(int thread_id)
 {
 	const uint8_t thread_stack = os_threads[thread_id].stack_id;
@@ -323,3 +395,90 @@ int mpu_init_stack(int thread_id)
 }
 
 
+
+bool mpu_user_accessible(const void * base, uint32_t size, bool write)
+{
+	if ((MPU_CTRL & MPU_CTRL_ENABLE) == 0)
+	{
+		return true;
+	}
+
+	uint64_t address = (uint32_t) base;
+	uint64_t end = address + size;
+	if (end > (1ULL << 32))
+	{
+		return false;
+	}
+
+	int regions = (MPU_TYPE & MPU_TYPE_DREGION) >> MPU_TYPE_DREGION_LSB;
+
+	/* Block is walked in pieces, each governed by one region. Region with
+	 * highest number which covers the address wins, same as in hardware.
+	 */
+	while (address < end)
+	{
+		uint64_t limit = end;
+		uint32_t access = 0;
+		bool covered = false;
+
+		for (int q = regions - 1; q >= 0 && !covered; --q)
+		{
+			MPU_RNR = ((q << MPU_RNR_REGION_LSB) & MPU_RNR_REGION);
+			uint32_t rasr = MPU_RASR;
+			if ((rasr & MPU_RASR_ENABLE) == 0)
+			{
+				continue;
+			}
+
+			uint64_t region_base = MPU_RBAR & MPU_RBAR_ADDR;
+			uint64_t region_size = 2ULL << ((rasr & MPU_RASR_SIZE) >> MPU_RASR_SIZE_LSB);
+			if (address < region_base)
+			{
+				/* Region may take over further in the block */
+				if (region_base < limit)
+				{
+					limit = region_base;
+				}
+				continue;
+			}
+
+			if (address >= region_base + region_size)
+			{
+				continue;
+			}
+
+			/* Regions of 256 bytes and more are split into eight subregions */
+			uint64_t subregion_size = region_size >= 256 ? region_size / 8 : region_size;
+			unsigned subregion = (uint32_t) (address - region_base) / (uint32_t) subregion_size;
+			uint64_t subregion_end = region_base + (subregion + 1) * subregion_size;
+			if (subregion_end < limit)
+			{
+				limit = subregion_end;
+			}
+
+			if (region_size >= 256 && (rasr & (1 << (MPU_RASR_SRD_LSB + subregion))) != 0)
+			{
+				/* Disabled subregion, address belongs to lower regions */
+				continue;
+			}
+
+			access = rasr & MPU_RASR_ATTR_AP;
+			covered = true;
+		}
+
+		if (!covered)
+		{
+			return false;
+		}
+
+		if (access != MPU_RASR_ATTR_AP_PRW_URW
+				&& (write || access != MPU_RASR_ATTR_AP_PRW_URO))
+		{
+			return false;
+		}
+
+		address = limit;
+	}
+
+	return true;
+}
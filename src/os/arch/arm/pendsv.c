@@ -13,12 +13,15 @@
 #include <cmrx/os/sanitize.h>
 #include <cmrx/os/sched.h>
 #include <cmrx/os/signal.h>
+#include <cmrx/os/isr.h>
 
 #include <arch/scb.h>
+#include <arch/ras_priv.h>
 
 #ifdef KERNEL_HAS_MEMORY_PROTECTION
 #	include <cmrx/os/mpu.h>
 #   include <arch/mpu_priv.h>
+#   include <cmrx/os/arch/mpu.h>
 #endif
 
 static struct OS_thread_t * old_task;
@@ -33,6 +36,7 @@ static struct OS_process_t * new_host_process;
 static uint8_t new_thread_id;
 static Process_t new_process_id;
 static bool ctxt_switch_pending;
+static bool ctxt_saved;
 
 extern struct OS_stack_t os_stacks;
 
@@ -47,30 +51,44 @@ bool schedule_context_switch(uint32_t current_task, uint32_t next_task)
 {
 	if (ctxt_switch_pending)
 	{
-		// can this be any more robust?
-		return false;
-	}
-
-	ctxt_switch_pending = true;
-
-	old_task = &os_threads[current_task];
-	old_parent_process = &os_processes[old_task->process_id];
-
-	if (old_task->rpc_stack[0] != 0)
-	{
-		old_host_process = &os_processes[old_task->rpc_stack[old_task->rpc_stack[0]]];
+		if (current_task != new_thread_id)
+		{
+			// can this be any more robust?
+			return false;
+		}
+
+		/* Switch was not performed yet and some thread became more urgent
+		 * than the incoming one meanwhile. It replaces the incoming thread,
+		 * outgoing thread stays the same.
+		 */
+		if (new_task->state == THREAD_STATE_RUNNING)
+		{
+			new_task->state = THREAD_STATE_READY;
+		}
 	}
 	else
 	{
-		old_host_process = old_parent_process;
-	}
-
-	if (os_threads[current_task].state == THREAD_STATE_RUNNING)
-	{
-		// only mark leaving thread as ready, if it was runnig before
-		// if leaving thread was, for example, quit before calling
-		// os_sched_yield, then this would return it back to life
-		os_threads[current_task].state = THREAD_STATE_READY;
+		ctxt_switch_pending = true;
+
+		old_task = &os_threads[current_task];
+		old_parent_process = &os_processes[old_task->process_id];
+
+		if (old_task->rpc_stack[0] != 0)
+		{
+			old_host_process = &os_processes[old_task->rpc_stack[old_task->rpc_stack[0]]];
+		}
+		else
+		{
+			old_host_process = old_parent_process;
+		}
+
+		if (os_threads[current_task].state == THREAD_STATE_RUNNING)
+		{
+			// only mark leaving thread as ready, if it was runnig before
+			// if leaving thread was, for example, quit before calling
+			// os_sched_yield, then this would return it back to life
+			os_threads[current_task].state = THREAD_STATE_READY;
+		}
 	}
 	new_task = &os_threads[next_task];
 	new_parent_process = &os_processes[new_task->process_id];
@@ -96,11 +114,59 @@ bool schedule_context_switch(uint32_t current_task, uint32_t next_task)
 	return true;
 }
 
+struct OS_thread_t * os_context_live_thread(void)
+{
+	if (ctxt_saved)
+	{
+		/* PendSV is in between storing and loading context */
+		return NULL;
+	}
+
+	if (ctxt_switch_pending)
+	{
+		return old_task;
+	}
+
+	return &os_threads[os_get_current_thread()];
+}
+
+/** Process deferred requests and tell if task switch is needed.
+ * Executes requests posted by interrupt service routines. These may cause
+ * task switch to be scheduled, or retarget switch which is pending already.
+ * Requests are executed with interrupts enabled, so their amount does not
+ * add to interrupt latency. Interrupt service routines can only post new
+ * requests meanwhile. Interrupts are disabled once this function returns.
+ * @returns true if task switch is pending
+ */
+__attribute__((noinline)) static bool pendsv_prepare(void)
+{
+	os_isr_drain();
+	cortex_disable_interrupts();
+	if (ctxt_switch_pending)
+	{
+		/* Requests may have woken thread more urgent than the one
+		 * switch was scheduled to. Retarget the switch then.
+		 */
+		os_sched_yield();
+	}
+#ifdef __ARM_ARCH_6M__
+	if (!ctxt_switch_pending && os_threads[os_get_current_thread()].state == THREAD_STATE_RUNNING)
+	{
+		/* Returning back into interrupted thread, whose restartable
+		 * sequence might have been affected by requests.
+		 */
+		os_ras_rewind_frame((ExceptionFrame *) __get_PSP());
+	}
+#endif
+	return ctxt_switch_pending;
+}
+
 /** Handle task switch.
  * This function performs the heavy lifting of context switching
  * when CPU is switched from one task to another.
- * As of now, it stores outgoing task's application context onto stack
- * and restores incoming task's context from its stack.
+ * First it processes requests posted by interrupt service routines.
+ * Then, if task switch is pending, it stores outgoing task's application
+ * context onto stack and restores incoming task's context from its stack.
  * It then sets PSP to point to incoming task's stack and resumes
  * normal operation.
  */
@@ -111,11 +177,23 @@ __attribute__((naked)) void PendSV_Handler(void)
 			".syntax unified\n\t"
 			"push {lr}\n\t"
 	);
-	cortex_disable_interrupts();
+	/* Called function preserves R4 - R11 so context is still intact */
+	if (!pendsv_prepare())
+	{
+		/* Pended by interrupt service routine and nothing to switch */
+		cortex_enable_interrupts();
+		asm volatile(
+				"pop {pc}"
+		);
+	}
 	/* Do NOT put anything here. You will clobber context being stored! */
 	old_task->sp = save_context();
+	ctxt_saved = true;
 	ctxt_switch_pending = false;
 	sanitize_psp(old_task->sp);
+#ifdef __ARM_ARCH_6M__
+	os_ras_rewind(old_task);
+#endif
 
 #ifdef KERNEL_HAS_MEMORY_PROTECTION
 	if (old_parent_process != new_parent_process || old_host_process != new_host_process)
@@ -127,17 +205,16 @@ __attribute__((naked)) void PendSV_Handler(void)
 	
 	// Configure stack for incoming process
 	mpu_set_region(OS_MPU_REGION_STACK, &os_stacks.stacks[new_thread_id], sizeof(os_stacks.stacks[new_thread_id]), MPU_RW);
+	mpu_load_window(os_thread_window(new_thread_id));
+	mpu_load_buffer_view(&new_parent_process->buffer_view);
 	sanitize_psp(new_task->sp);
 
-	if (new_task->signals != 0 && new_task->signal_handler != NULL)
-	{
-		os_deliver_signal(new_task, new_task->signals);
-		new_task->signals = 0;
-	}
+	os_deliver_pending_signals(new_task);
 	load_context(new_task->sp);
 	/* Do NOT put anything here. You will clobber context just restored! */
 	__ISB();
 	__DSB();
+	ctxt_saved = false;
 
 	cortex_enable_interrupts();
 	asm volatile(
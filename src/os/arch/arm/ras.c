@@ -0,0 +1,34 @@
+/** @addtogroup arch_arm_ras
+ * @{
+ */
+#include <arch/ras_priv.h>
+#include <arch/cortex.h>
+#include <cmrx/os/runtime.h>
+
+extern const struct RAS_sequence_t __ras_table_start;
+extern const struct RAS_sequence_t __ras_table_end;
+
+void os_ras_rewind(struct OS_thread_t * thread)
+{
+	// Saved context starts with 8 general purpose registers stored by
+	// pend_sv_handler, exception frame follows.
+	os_ras_rewind_frame((ExceptionFrame *) (thread->sp + 8));
+}
+
+void os_ras_rewind_frame(ExceptionFrame * frame)
+{
+	uint32_t pc = (uint32_t) frame->pc;
+
+	for (const struct RAS_sequence_t * sequence = &__ras_table_start; sequence < &__ras_table_end; ++sequence)
+	{
+		/* Labels may carry Thumb bit, exception frame PC never does */
+		uint32_t start = sequence->start & ~1;
+		if (pc >= start && pc < (sequence->end & ~1))
+		{
+			frame->pc = (void *) start;
+			return;
+		}
+	}
+}
+
+/** @} */
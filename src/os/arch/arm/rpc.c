@@ -8,10 +8,23 @@
  * instead of returning to where it came from. Returning will then jump into specially
  * crafted routine, that injects rpc_return system call. This restores the previous 
  * state of caller's stack while copying the return value.
+ *
+ * RPC call may be given a deadline. If the deadline expires before method returns,
+ * the caller's exception frame is reinstated and all the frames synthesized since
+ * are thrown away. As the thread may be interrupted anywhere in the callee code,
+ * caller's callee-saved registers are preserved by the userspace part of the call,
+ * rather than by the kernel.
+ *
+ * Asynchronous requests are executed by server threads of the target process. When
+ * server thread calls rpc_serve(), the same kind of artificial exception frame is
+ * injected into its stack. Returning from the method then injects rpc_async_return
+ * system call, which stores the return value into the request and lets rpc_serve()
+ * return.
  * 
  * @{
  */
 #include <cmrx/os/rpc.h>
+#include <cmrx/os/rpc_stats.h>
 #include <cmrx/os/syscalls.h>
 #include <cmrx/os/syscall.h>
 #include <arch/cortex.h>
@@ -19,6 +32,7 @@
 #include <arch/mpu_priv.h>
 #include <cmrx/os/runtime.h>
 #include <cmrx/os/sched.h>
+#include <cmrx/os/arch/sched.h>
 #include <conf/kernel.h>
 
 #include <cmrx/assert.h>
@@ -26,16 +40,18 @@
 
 
 void rpc_return();
+void rpc_async_return();
 
-int os_rpc_call(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3)
+/** Transfer control into RPC method.
+ * Validates the service, switches MPU to process owning the service and
+ * synthesizes exception frame which calls the method.
+ * @param local_frame exception frame of the caller
+ * @param service address of service instance
+ * @param method_id index of method in service vtable
+ * @returns E_OK if method will be called, error code otherwise
+ */
+static int do_rpc_call(ExceptionFrame * local_frame, RPC_Service_t * service, unsigned method_id)
 {
-    (void) arg0;
-    (void) arg1;
-    (void) arg2;
-    (void) arg3;
-	ExceptionFrame * local_frame = (ExceptionFrame *) __get_PSP();
-	sanitize_psp((uint32_t *) local_frame);
-	RPC_Service_t * service = (void *) get_exception_argument(local_frame, 4);
 	VTable_t * vtable = service->vtable;
 
 	Process_t process_id = get_vtable_process(vtable);
@@ -50,8 +66,8 @@ int os_rpc_call(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3)
 	}
 
 	mpu_load(&os_processes[process_id].mpu, 0, MPU_HOSTED_STATE_SIZE);
+	os_rpc_stats_enter(os_get_current_thread(), process_id, vtable, method_id);
 
-	unsigned method_id = get_exception_argument(local_frame, 5); 
 	RPC_Method_t * method = vtable[method_id];
 /*	unsigned canary = get_exception_argument(local_frame, 6);
 
@@ -74,6 +90,25 @@ int os_rpc_call(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3)
 	
 	__set_PSP((uint32_t) remote_frame);
 
+	return E_OK;
+}
+
+int os_rpc_call(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3)
+{
+    (void) arg1;
+    (void) arg2;
+    (void) arg3;
+	ExceptionFrame * local_frame = (ExceptionFrame *) __get_PSP();
+	sanitize_psp((uint32_t *) local_frame);
+	RPC_Service_t * service = (void *) get_exception_argument(local_frame, 4);
+	unsigned method_id = get_exception_argument(local_frame, 5); 
+
+	int rv = do_rpc_call(local_frame, service, method_id);
+	if (rv != E_OK)
+	{
+		return rv;
+	}
+
 	// we have manipulated PSP, but sv_call_handler doesn't know
 	// about it. we will let rewrite R0 position in exception
 	// stack frame by arg0 value, which actually is the same value
@@ -94,8 +129,9 @@ int os_rpc_return(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3)
 
 	ASSERT(canary == 0xAA55AA55);*/
 
-	ExceptionFrame * local_frame = 0; //pop_exception_frame(remote_frame, 2);
+	ExceptionFrame * local_frame = pop_exception_frame(remote_frame, 2);
 	
+	os_rpc_stats_leave(os_get_current_thread(), false);
 	int pstack_depth = rpc_stack_pop();
 	Process_t process_id;
 
@@ -142,8 +178,165 @@ int os_rpc_return(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3)
 	
 	set_exception_argument(local_frame, 0, arg0);
 	__ISB();
+
+	os_rpc_deadline_clear((uint32_t *) local_frame);
 	
 	return arg0;
 }
 
+/** Amount of callee-saved registers pushed by @ref _rpc_call_timed() before entering
+ * the kernel. Arguments passed on stack are located above them.
+ */
+#define RPC_TIMED_SAVED_REGS		8
+
+int os_rpc_call_timed(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3)
+{
+    (void) arg1;
+    (void) arg2;
+    (void) arg3;
+	ExceptionFrame * local_frame = (ExceptionFrame *) __get_PSP();
+	sanitize_psp((uint32_t *) local_frame);
+	RPC_Service_t * service = (void *) get_exception_argument(local_frame, RPC_TIMED_SAVED_REGS + 4);
+	unsigned method_id = get_exception_argument(local_frame, RPC_TIMED_SAVED_REGS + 5);
+	unsigned timeout = get_exception_argument(local_frame, RPC_TIMED_SAVED_REGS + 6);
+
+	int rv = os_rpc_deadline_set((uint32_t *) local_frame, timeout);
+	if (rv != E_OK)
+	{
+		return rv;
+	}
+
+	rv = do_rpc_call(local_frame, service, method_id);
+	if (rv != E_OK)
+	{
+		os_rpc_deadline_clear((uint32_t *) local_frame);
+		return rv;
+	}
+
+	// PSP has been manipulated, see os_rpc_call()
+	return arg0;
+}
+
+void os_rpc_unwind(Thread_t thread_id, uint32_t * frame, int retval)
+{
+	ExceptionFrame * local_frame = (ExceptionFrame *) frame;
+	struct OS_thread_t * thread = os_thread_get(thread_id);
+	set_exception_argument(local_frame, 0, retval);
+
+	if (thread == os_context_live_thread())
+	{
+		if (thread_id == os_get_current_thread())
+		{
+			Process_t process_id = rpc_stack_top();
+			if (process_id == E_VTABLE_UNKNOWN)
+			{
+				process_id = os_get_current_process();
+			}
+			mpu_load(&os_processes[process_id].mpu, 0, MPU_HOSTED_STATE_SIZE);
+		}
+		// Otherwise thread is being switched out and its stack pointer
+		// is stale. PendSV saves its context from PSP and its memory
+		// protection is loaded once it is switched in again.
+
+		// Hardware will unstack the caller's frame once the handler returns
+		__set_PSP((uint32_t) local_frame);
+		__ISB();
+	}
+	else
+	{
+		// Forge context, as if the thread was switched out right after it
+		// returned from the syscall. Values of r4 - r11 don't matter, they
+		// are restored by _rpc_call_timed() itself.
+		thread->sp = (unsigned long *) (frame - 8);
+	}
+}
+
+int os_rpc_call_async(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3)
+{
+	ExceptionFrame * local_frame = (ExceptionFrame *) __get_PSP();
+	sanitize_psp((uint32_t *) local_frame);
+	RPC_Service_t * service = (void *) get_exception_argument(local_frame, 4);
+	unsigned method_id = get_exception_argument(local_frame, 5);
+	uint32_t signal = get_exception_argument(local_frame, 6);
+	uint32_t args[4] = { arg0, arg1, arg2, arg3 };
+
+	if (signal & RPC_NOTIFY_FLAG)
+	{
+		int rv = os_rpc_request_submit(service, method_id, args, RPC_NO_SIGNAL, RPC_REQUEST_FLAG_NOTIFY);
+		return rv < 0 ? rv : E_OK;
+	}
+
+	return os_rpc_request_submit(service, method_id, args, signal, 0);
+}
+
+int os_rpc_call_queued(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3)
+{
+	ExceptionFrame * local_frame = (ExceptionFrame *) __get_PSP();
+	sanitize_psp((uint32_t *) local_frame);
+	RPC_Service_t * service = (void *) get_exception_argument(local_frame, 4);
+	unsigned method_id = get_exception_argument(local_frame, 5);
+	uint32_t args[4] = { arg0, arg1, arg2, arg3 };
+
+	return os_rpc_request_call(service, method_id, args);
+}
+
+int os_rpc_serve(void)
+{
+	ExceptionFrame * local_frame = (ExceptionFrame *) __get_PSP();
+	sanitize_psp((uint32_t *) local_frame);
+
+	struct OS_RPC_request_t * request = os_rpc_request_fetch(os_get_current_process(), os_get_current_thread());
+	if (request == NULL)
+	{
+		/* Nothing to do right now. Rewind PC back to the SVC instruction,
+		 * so the syscall is executed again once thread is woken up.
+		 * SVC is always a 16-bit instruction.
+		 */
+		local_frame->pc = (void *) ((uint32_t) local_frame->pc - 2);
+		return os_rpc_request_wait();
+	}
+
+	RPC_Method_t * method = request->service->vtable[request->method];
+
+	ExceptionFrame * remote_frame = push_exception_frame(local_frame, 2);
+	sanitize_psp((uint32_t *) remote_frame);
+
+	for (int q = 0; q < 4; ++q)
+	{
+		set_exception_argument(remote_frame, q + 1, request->args[q]);
+	}
+
+	set_exception_argument(remote_frame, 0, (uint32_t) request->service);
+	set_exception_argument(remote_frame, 5, 0xAA55AA55);
+	set_exception_pc_lr(remote_frame, method, rpc_async_return);
+
+	__set_PSP((uint32_t) remote_frame);
+
+	// sv_call_handler will write return value into R0 of local
+	// frame, which is overwritten by os_rpc_async_return anyway
+	return E_OK;
+}
+
+int os_rpc_async_return(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3)
+{
+    (void) arg1;
+    (void) arg2;
+    (void) arg3;
+	ExceptionFrame * remote_frame = (ExceptionFrame *) __get_PSP();
+	sanitize_psp((uint32_t *) remote_frame);
+
+	ExceptionFrame * local_frame = pop_exception_frame(remote_frame, 2);
+	sanitize_psp((uint32_t *) local_frame);
+
+	os_rpc_request_complete(os_get_current_thread(), arg0);
+
+	__set_PSP((uint32_t) local_frame);
+
+	// rpc_serve() returns E_OK once request has been served
+	set_exception_argument(local_frame, 0, E_OK);
+	__ISB();
+
+	return E_OK;
+}
+
 /** @} */
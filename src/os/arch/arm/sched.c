@@ -15,6 +15,7 @@
 #include <cmrx/os/mpu.h>
 #include <arch/mpu.h>
 #include <arch/mpu_priv.h>
+#include <arch/scb.h>
 #include <string.h>
 
 #ifdef TESTING
@@ -73,6 +74,72 @@ int os_process_create(Process_t process_id, const struct OS_process_definition_t
 	return E_OK;
 }
 
+uint32_t os_cycle_count(void)
+{
+#ifdef __ARM_ARCH_6M__
+	// No cycle counter on ARMv6-M, fall back to scheduler time
+	return os_get_micro_time();
+#else
+	if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0)
+	{
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+	return DWT->CYCCNT;
+#endif
+}
+
+void os_set_syscall_return_value(Thread_t thread_id, int value)
+{
+	struct OS_thread_t * thread = os_thread_get(thread_id);
+	ExceptionFrame * frame;
+	if (thread == os_context_live_thread())
+	{
+		// Thread blocked, but it wasn't switched out yet. Its thread->sp
+		// is stale and exception frame is on top of process stack.
+		frame = (ExceptionFrame *) __get_PSP();
+	}
+	else
+	{
+		// Saved context starts with 8 general purpose registers stored by
+		// pend_sv_handler, exception frame follows.
+		frame = (ExceptionFrame *) (thread->sp + 8);
+	}
+	frame->r0123[0] = value;
+}
+
+bool os_atomic_compare_exchange(volatile uint32_t * addr, uint32_t expected, uint32_t desired)
+{
+#ifdef __ARM_ARCH_6M__
+	/* No exclusive access instructions here */
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	bool exchanged = (*addr == expected);
+	if (exchanged)
+	{
+		*addr = desired;
+	}
+	__set_PRIMASK(primask);
+	return exchanged;
+#else
+	do {
+		if (__LDREXW(addr) != expected)
+		{
+			__CLREX();
+			return false;
+		}
+	} while (__STREXW(desired, addr) != 0);
+	return true;
+#endif
+}
+
+void os_pend_isr_requests(void)
+{
+	/* ICSR bits are write-one-to-set, no need to read it first */
+	SCB_ICSR = SCB_ICSR_PENDSVSET;
+	__DSB();
+}
+
 /// @cond IGNORE
 __attribute__((naked,noreturn)) 
 /// @endcond
@@ -12,96 +12,174 @@
 #include <cmrx/os/syscall.h>
 #include <arch/cortex.h>
 
+/** Amount of words saved below original stack top of thread receiving signal.
+ * These are R4 - R7, R12, LR, xPSR, padding, R0 - R3 and PC of interrupted code.
+ */
+#define SIGNAL_SAVED_WORDS		13
+
+/** Index of padding word in saved area */
+#define SIGNAL_SAVED_PADDING	7
+
+/** Amount of words occupied by one entry of dispatch list: signal number and handler */
+#define SIGNAL_DISPATCH_WORDS	2
+
+/** Bits of xPSR holding IT/ICI execution state */
+#define XPSR_IT_ICI_MASK		0x0600FC00
+
 /** Perform signal delivery in thread's userspace.
- * This "function" is ever only called from os_deliver_signal(). It stores
- * original values of LR and R0 - R3 registers and PC onto stack. 
- * @param sighandler address of signal handler function. Guarranteed to be non-NULL. Yet not to be valid.
- * @param signal_mask Bitmask of activated (pending) signals, which are catchable by the application.
+ * This "function" is ever only entered via exception frame forged by
+ * os_deliver_signal(). It walks the dispatch list placed on top of stack
+ * and calls handler of each signal. Then it restores R4 - R7, R12, LR, flags,
+ * R0 - R3 and PC of interrupted code from stack. Padding word is skipped if
+ * bit 9 of saved xPSR is set.
+ *
+ * On entry R4 contains amount of entries in dispatch list, R5 contains value
+ * passed along with signals and R6 contains address of dispatch list. Each
+ * entry holds signal number and address of its handler. Handler is guarranteed
+ * to be non-NULL. Yet not to be valid.
  */
-__attribute__((naked)) static void os_fire_signal(uint32_t signal_mask, void *sighandler(void))
+__attribute__((naked)) static void os_fire_signal(void)
 {
-    (void) signal_mask;
-
 	asm volatile(
-			"BLX %[sighandler]\n\t"
-// was:		"POP { lr }\n\t"
-			"POP { r0 }\n\t"
-			"MOV lr, r0\n\t"
+			".syntax unified\n\t"
+			"1:\n\t"
+			"LDMIA r6!, { r0, r3 }\n\t"
+			"MOV r1, r5\n\t"
+			"BLX r3\n\t"
+			"SUBS r4, #1\n\t"
+			"BNE 1b\n\t"
+			"MOV sp, r6\n\t"
+			"POP { r4 - r7 }\n\t"
+			"POP { r0 - r2 }\n\t"
+			"MOV r12, r0\n\t"
+			"MOV lr, r1\n\t"
+			"LSLS r0, r2, #22\n\t"
+			"BPL 2f\n\t"
+			"ADD sp, #4\n\t"
+			"2:\n\t"
+			"MSR APSR_nzcvq, r2\n\t"
 			"POP { r0 - r3, pc }\n\t"
-			:
-			: [sighandler] "r" (sighandler)
 			);
 }
 
-void os_deliver_signal(struct OS_thread_t * thread, uint32_t signals)
+uint32_t os_deliver_signal(struct OS_thread_t * thread, uint32_t signals, uint32_t value)
 {
-	ExceptionFrame * frame;
-	uint32_t * new_sp;
+	uint32_t delivered = 0;
+	unsigned count = 0;
 
-	/* Signal handler being NULL means, that thread ignores signals. No delivery is performed. */
-	if (thread->signal_handler == NULL)
+	/* Only signals having handler registered are delivered. Others remain pending. */
+	for (uint32_t pending = signals; pending != 0; pending &= pending - 1)
 	{
-		return;
+		unsigned signo = __builtin_ctz(pending);
+		if (thread->signal_handlers[signo] != NULL)
+		{
+			delivered |= 1 << signo;
+			count++;
+		}
 	}
 
-	if (thread->state == THREAD_STATE_RUNNING)
+	if (count == 0)
 	{
-		/* Here it means, that SP shows to the beginning of thread state record.
-		 * Thread state record is basically just an exception frame, which has
-		 * additional registers placed on top of it. 
-		 */
-		frame = (ExceptionFrame *) (thread->sp + 8);
-		uint32_t * old_sp = thread->sp;
-		new_sp = old_sp - 6;
-		for (int q = 0; q < 8; ++q)
-		{
-			new_sp[q] = old_sp[q];
-		}
+		return 0;
 	}
-	else
+
+	/* Thread's SP points to the beginning of thread state record.
+	 * Thread state record is basically just an exception frame, which has
+	 * additional registers R4 - R11 placed on top of it.
+	 */
+	uint32_t * old_sp = (uint32_t *) thread->sp;
+	ExceptionFrame * frame = (ExceptionFrame *) (old_sp + 8);
+
+	if ((frame->xpsr & XPSR_IT_ICI_MASK) != 0)
 	{
-        /* TODO: Deliver signals to threads, which are not running. */
-		ASSERT(0);
-        return;
+		/* Thread was interrupted in the middle of IT block or multi-register
+		 * transfer. This state can't be restored from userspace. Postpone.
+		 */
+		return 0;
 	}
-	
-	/* Create space for 5 values: R0 - R3, PC */
-	ExceptionFrame * signal_frame = shim_exception_frame(frame, 6);
 
-#define STACK_BASE	5
+	/* Value of thread's SP before exception frame was stored. Signal frame is
+	 * built below it so that frames of any depth nest properly.
+	 */
+	uint32_t * thread_sp = ((uint32_t *) frame) + EXCEPTION_FRAME_SIZE + ((frame->xpsr >> 9) & 1);
+	uint32_t padding = (((uint32_t) thread_sp) % 8) != 0 ? 1 : 0;
 
-	set_exception_argument(signal_frame, STACK_BASE - 1, (uint32_t) signal_frame->lr);
+	/* Dispatch list and saved area must be 8-byte aligned as signal handlers
+	 * are called with SP pointing to them.
+	 */
+	uint32_t * saved = thread_sp - (SIGNAL_SAVED_WORDS - 1) - padding;
+	uint32_t * dispatch = saved - count * SIGNAL_DISPATCH_WORDS;
+	ExceptionFrame * signal_frame = (ExceptionFrame *) (dispatch - EXCEPTION_FRAME_SIZE);
+	uint32_t * new_sp = ((uint32_t *) signal_frame) - 8;
 
-	/* Save R0 - R4 */
+	if (thread->stack_id >= OS_STACKS || new_sp < (uint32_t *) &os_stacks.stacks[thread->stack_id][0])
+	{
+		return 0;
+	}
+
+	/* Areas may overlap, take copy of current context first */
+	uint32_t context[8];
+	ExceptionFrame interrupted = *frame;
+	for (int q = 0; q < 8; ++q)
+	{
+		context[q] = old_sp[q];
+	}
+
+	/* Context record holds R8 - R11 followed by R4 - R7 */
+	for (int q = 0; q < 4; ++q)
+	{
+		saved[q] = context[4 + q];
+	}
+	saved[4] = interrupted.r12;
+	saved[5] = (uint32_t) interrupted.lr;
+	saved[6] = (interrupted.xpsr & ~(1 << 9)) | (padding << 9);
+	if (padding)
+	{
+		saved[SIGNAL_SAVED_PADDING] = 0;
+	}
 	for (int q = 0; q < 4; ++q)
 	{
-		set_exception_argument(signal_frame, STACK_BASE + q, get_exception_argument(signal_frame, q));
+		saved[SIGNAL_SAVED_PADDING + padding + q] = interrupted.r0123[q];
 	}
-	/* Save PC */
 	/* Note that bit 0 is programmatically set to 1. Otherwise CPU will freak out during
 	 * return. Exception frame stores PC as verbatim value. If this is used for loading PC
 	 * other way than loading from exception frame, then CPU attempts to switch into ARM
 	 * mode, which makes Cortex-M sad panda.
 	 */
-	set_exception_argument(signal_frame, STACK_BASE + 4, (uint32_t) signal_frame->pc | 1);
-	/* R0 - arg[0] - signal_mask */
-	set_exception_argument(signal_frame, 0, signals);
+	saved[SIGNAL_SAVED_PADDING + padding + 4] = (uint32_t) interrupted.pc | 1;
 
-	/* R1 - arg[1] - sighandler */
-	set_exception_argument(signal_frame, 1, (uint32_t) thread->signal_handler);
-
-	/* PC - os_fire_signal */
-	signal_frame->pc = os_fire_signal;
+	/* Lowest signal number has highest priority and is dispatched first */
+	uint32_t * entry = dispatch;
+	for (uint32_t pending = delivered; pending != 0; pending &= pending - 1)
+	{
+		unsigned signo = __builtin_ctz(pending);
+		entry[0] = signo;
+		entry[1] = (uint32_t) thread->signal_handlers[signo];
+		entry += SIGNAL_DISPATCH_WORDS;
+	}
 
-	if (thread->state == THREAD_STATE_RUNNING)
+	for (int q = 0; q < 4; ++q)
 	{
-		thread->sp = (uint32_t *) new_sp;
-//		__set_PSP((uint32_t *) signal_frame);
+		signal_frame->r0123[q] = 0;
 	}
-	else
+	signal_frame->r12 = 0;
+	signal_frame->lr = interrupted.lr;
+	signal_frame->pc = os_fire_signal;
+	/* Thumb state only, dispatch list is aligned so frame is never padded */
+	signal_frame->xpsr = 1 << 24;
+
+	/* R4 - R6 carry dispatch state, R7 - R11 stay as they were */
+	context[4] = count;
+	context[5] = value;
+	context[6] = (uint32_t) dispatch;
+	for (int q = 0; q < 8; ++q)
 	{
-		ASSERT(0);
+		new_sp[q] = context[q];
 	}
+
+	thread->sp = (unsigned long *) new_sp;
+
+	return delivered;
 }
 
 /** @} */
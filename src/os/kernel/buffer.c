@@ -0,0 +1,134 @@
+/** @addtogroup os_buffer
+ * @{
+ */
+#include <cmrx/os/buffer.h>
+#include <cmrx/os/runtime.h>
+#include <cmrx/os/sched.h>
+#include <cmrx/os/mpu.h>
+#include <cmrx/os/arch/mpu.h>
+#include <cmrx/defines.h>
+#include <conf/kernel.h>
+#include <stdbool.h>
+
+#if OS_BUFFERS > 8
+#	error "At most 8 buffers are supported"
+#endif
+
+#if (OS_BUFFER_SIZE & (OS_BUFFER_SIZE - 1)) != 0 || OS_BUFFER_SIZE < 32
+#	error "Size of buffer has to be power of two, at least 32 bytes"
+#endif
+
+/** Size of MPU region covering whole pool, each buffer is one eighth of it */
+#define BUFFER_POOL_SIZE		(8 * OS_BUFFER_SIZE)
+
+/** Buffers. Pool is aligned to size of region covering it. */
+static uint8_t os_buffers[OS_BUFFERS][OS_BUFFER_SIZE] __attribute__((aligned(BUFFER_POOL_SIZE)));
+
+/** Process owning each buffer */
+static Process_t os_buffer_owner[OS_BUFFERS];
+
+/** Mask of allocated buffers */
+static uint8_t os_buffer_allocated = 0;
+
+/** Check if buffer is owned by process of calling thread.
+ * @param buffer handle of buffer
+ * @returns true if caller may use buffer
+ */
+static bool os_buffer_owned(int buffer)
+{
+	return buffer >= 0 && buffer < OS_BUFFERS
+		&& (os_buffer_allocated & (1 << buffer)) != 0
+		&& os_buffer_owner[buffer] == os_get_current_process();
+}
+
+/** Recalculate view of pool of given process.
+ * If calling thread belongs to the process, then new view is loaded
+ * immediately. Other threads load it when they are scheduled.
+ * @param process_id process whose buffers changed
+ */
+static void os_buffer_update_view(Process_t process_id)
+{
+	struct OS_MPU_window_t * view = &os_processes[process_id].buffer_view;
+	uint8_t owned = 0;
+
+	for (int q = 0; q < OS_BUFFERS; ++q)
+	{
+		if ((os_buffer_allocated & (1 << q)) != 0 && os_buffer_owner[q] == process_id)
+		{
+			owned |= 1 << q;
+		}
+	}
+
+	view->base = owned != 0 ? os_buffers : NULL;
+	view->size = BUFFER_POOL_SIZE;
+	view->flags = MPU_RW;
+	view->subregions = owned;
+
+	if (os_get_current_process() == process_id)
+	{
+		mpu_load_buffer_view(view);
+	}
+}
+
+int os_buffer_alloc(void)
+{
+	for (int q = 0; q < OS_BUFFERS; ++q)
+	{
+		if ((os_buffer_allocated & (1 << q)) == 0)
+		{
+			os_buffer_allocated |= 1 << q;
+			os_buffer_owner[q] = os_get_current_process();
+			os_buffer_update_view(os_buffer_owner[q]);
+			return q;
+		}
+	}
+
+	return -E_OUT_OF_RANGE;
+}
+
+void * os_buffer_address(int buffer)
+{
+	if (!os_buffer_owned(buffer))
+	{
+		return NULL;
+	}
+
+	return os_buffers[buffer];
+}
+
+int os_buffer_send(int buffer, Thread_t thread)
+{
+	if (!os_buffer_owned(buffer) || thread >= OS_THREADS
+			|| os_threads[thread].state == THREAD_STATE_EMPTY
+			|| os_threads[thread].state == THREAD_STATE_FINISHED)
+	{
+		return E_INVALID;
+	}
+
+	Process_t sender = os_buffer_owner[buffer];
+	Process_t recipient = os_threads[thread].process_id;
+
+	if (sender != recipient)
+	{
+		os_buffer_owner[buffer] = recipient;
+		os_buffer_update_view(sender);
+		os_buffer_update_view(recipient);
+	}
+
+	return E_OK;
+}
+
+int os_buffer_free(int buffer)
+{
+	if (!os_buffer_owned(buffer))
+	{
+		return E_INVALID;
+	}
+
+	os_buffer_allocated &= ~(1 << buffer);
+	os_buffer_update_view(os_buffer_owner[buffer]);
+
+	return E_OK;
+}
+
+/** @} */
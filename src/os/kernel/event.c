@@ -0,0 +1,228 @@
+/** @addtogroup os_event
+ * @{
+ */
+#include <cmrx/os/event.h>
+#include <cmrx/os/notify.h>
+#include <cmrx/os/runtime.h>
+#include <cmrx/os/sched.h>
+#include <cmrx/os/arch/sched.h>
+#include <cmrx/os/arch/mpu.h>
+#include <cmrx/ipc/event.h>
+#include <cmrx/defines.h>
+#include <conf/kernel.h>
+#include <stdbool.h>
+
+/** Event group kernel object */
+struct OS_event_group_t {
+	/** Current state of flags */
+	uint32_t bits;
+	/** Process owning the event group */
+	Process_t owner;
+	/** True if event group is in use */
+	bool allocated;
+};
+
+static struct OS_event_group_t os_event_groups[OS_EVENT_GROUPS];
+
+/** Translate event group handle to kernel object.
+ * @param group event group handle
+ * @returns address of event group or NULL if handle is not valid
+ */
+static struct OS_event_group_t * os_event_group_get(int group)
+{
+	if (group < 0 || group >= OS_EVENT_GROUPS || !os_event_groups[group].allocated)
+	{
+		return NULL;
+	}
+
+	return &os_event_groups[group];
+}
+
+/** Check if wait condition is satisfied.
+ * @param bits current state of flags
+ * @param mask flags waited for
+ * @param flags wait flags
+ * @returns true if waiter can be woken up
+ */
+static bool os_event_satisfied(uint32_t bits, uint32_t mask, unsigned flags)
+{
+	if (flags & EVENT_WAIT_ALL)
+	{
+		return (bits & mask) == mask;
+	}
+
+	return (bits & mask) != 0;
+}
+
+/** Wake up threads whose condition is satisfied.
+ * Waiters are examined in order of their priority, so flags consumed by
+ * higher priority waiter are not seen by lower priority ones.
+ * @param group event group
+ */
+static void os_event_group_wake(struct OS_event_group_t * group)
+{
+	while (true)
+	{
+		Thread_t candidate = OS_THREADS;
+		struct OS_wait_entry_t * wait = NULL;
+		int entry = 0;
+
+		for (Thread_t q = 0; q < OS_THREADS; ++q)
+		{
+			int index = os_wait_entry(q, group);
+			if (index >= 0
+					&& os_event_satisfied(group->bits, os_threads[q].wait_list[index].mask, os_threads[q].wait_list[index].flags))
+			{
+				if (candidate == OS_THREADS || os_threads[q].priority < os_threads[candidate].priority)
+				{
+					candidate = q;
+					entry = index;
+					wait = &os_threads[q].wait_list[index];
+				}
+			}
+		}
+
+		if (candidate == OS_THREADS)
+		{
+			return;
+		}
+
+		if (os_threads[candidate].block_object == (unsigned long) group)
+		{
+			*(uint32_t *) os_threads[candidate].wait_result = group->bits;
+		}
+
+		if (wait->flags & EVENT_WAIT_CLEAR)
+		{
+			group->bits &= ~wait->mask;
+		}
+
+		os_notify_waiter(candidate, entry, E_OK);
+	}
+}
+
+const void * os_event_group_object(int group_id)
+{
+	return os_event_group_get(group_id);
+}
+
+uint32_t os_event_group_poll(int group_id, uint32_t bits, unsigned flags)
+{
+	struct OS_event_group_t * group = os_event_group_get(group_id);
+	if (group == NULL || !os_event_satisfied(group->bits, bits, flags))
+	{
+		return 0;
+	}
+
+	uint32_t current = group->bits;
+	if (flags & EVENT_WAIT_CLEAR)
+	{
+		group->bits &= ~bits;
+	}
+	return current;
+}
+
+int os_event_group_create(void)
+{
+	for (int q = 0; q < OS_EVENT_GROUPS; ++q)
+	{
+		if (!os_event_groups[q].allocated)
+		{
+			os_event_groups[q].bits = 0;
+			os_event_groups[q].owner = os_get_current_process();
+			os_event_groups[q].allocated = true;
+			return q;
+		}
+	}
+
+	return -E_OUT_OF_RANGE;
+}
+
+int os_event_group_delete(int group_id)
+{
+	struct OS_event_group_t * group = os_event_group_get(group_id);
+	if (group == NULL || group->owner != os_get_current_process())
+	{
+		return E_INVALID;
+	}
+
+	while (os_notify_object_deleted(group, E_DELETED))
+		;
+
+	group->allocated = false;
+	return E_OK;
+}
+
+int os_event_group_set(int group_id, uint32_t bits)
+{
+	struct OS_event_group_t * group = os_event_group_get(group_id);
+	if (group == NULL)
+	{
+		return E_INVALID;
+	}
+
+	group->bits |= bits;
+	os_event_group_wake(group);
+
+	return E_OK;
+}
+
+int os_event_group_clear(int group_id, uint32_t bits)
+{
+	struct OS_event_group_t * group = os_event_group_get(group_id);
+	if (group == NULL)
+	{
+		return E_INVALID;
+	}
+
+	group->bits &= ~bits;
+
+	return E_OK;
+}
+
+int os_event_group_wait(int group_id, uint32_t * bits, unsigned flags, unsigned microseconds)
+{
+	if (((uint32_t) bits % sizeof(uint32_t)) != 0)
+	{
+		return E_MISALIGNED;
+	}
+
+	if (!mpu_user_accessible(bits, sizeof(uint32_t), true))
+	{
+		return E_INVALID_ADDRESS;
+	}
+
+	struct OS_event_group_t * group = os_event_group_get(group_id);
+	if (group == NULL || *bits == 0)
+	{
+		return E_INVALID;
+	}
+
+	uint32_t current = os_event_group_poll(group_id, *bits, flags);
+	if (current != 0)
+	{
+		*bits = current;
+		return E_OK;
+	}
+
+	if (microseconds == 0)
+	{
+		return E_TIMEOUT;
+	}
+
+	struct OS_thread_t * thread = &os_threads[os_get_current_thread()];
+	struct OS_wait_entry_t * wait = &thread->wait_list[0];
+	wait->object = (unsigned long) group;
+	wait->mask = *bits;
+	wait->flags = flags;
+	thread->wait_result = bits;
+	os_wait_for_object_timeout(group, microseconds);
+
+	/* This is returned if wait times out. If condition gets satisfied,
+	 * then os_event_group_wake() replaces it by E_OK and stores state of
+	 * flags. Deletion of group replaces it by E_DELETED.
+	 */
+	return E_TIMEOUT;
+}
+
+/** @} */
@@ -0,0 +1,113 @@
+/** @addtogroup os_futex
+ * @{
+ */
+#include <cmrx/os/futex.h>
+#include <cmrx/ipc/sem.h>
+#include <cmrx/os/notify.h>
+#include <cmrx/os/lock_profile.h>
+#include <cmrx/os/runtime.h>
+#include <cmrx/os/sched.h>
+#include <cmrx/os/arch/mpu.h>
+#include <cmrx/defines.h>
+#include <conf/kernel.h>
+
+int os_futex_wait(uint32_t * address, uint32_t expected, unsigned microseconds)
+{
+	if (((uint32_t) address % sizeof(uint32_t)) != 0)
+	{
+		return E_MISALIGNED;
+	}
+
+	if (!mpu_user_accessible(address, sizeof(uint32_t), false))
+	{
+		return E_INVALID_ADDRESS;
+	}
+
+	if (*address != expected)
+	{
+		return E_BUSY;
+	}
+
+	if (microseconds == 0)
+	{
+		return E_TIMEOUT;
+	}
+
+	os_lock_profile_wait(os_get_current_thread(), address);
+
+	int rv = os_wait_for_object_timeout(address, microseconds);
+	if (rv != E_OK)
+	{
+		return rv;
+	}
+
+	/* This is returned if wait times out. If futex is woken up,
+	 * then os_futex_wake() replaces it by E_OK.
+	 */
+	return E_TIMEOUT;
+}
+
+int os_futex_wake(uint32_t * address, unsigned count)
+{
+	unsigned woken = 0;
+
+	while (woken < count && os_notify_object_value(address, E_OK))
+	{
+		woken++;
+	}
+
+	return woken;
+}
+
+int os_sem_give(uint32_t * value)
+{
+	if (((uint32_t) value % sizeof(uint32_t)) != 0)
+	{
+		return E_MISALIGNED;
+	}
+
+	/* Nothing else runs while kernel executes, plain access is atomic */
+	*value = ((*value + 1) & SEM_COUNT) | (*value & SEM_WAITERS);
+
+	if ((*value & SEM_WAITERS) != 0 && os_futex_wake(value, 1) == 0)
+	{
+		*value &= ~SEM_WAITERS;
+	}
+
+	return E_OK;
+}
+
+int os_futex_requeue(uint32_t * address, unsigned count, uint32_t * target)
+{
+	if (((uint32_t) target % sizeof(uint32_t)) != 0)
+	{
+		return 0;
+	}
+
+	unsigned woken = os_futex_wake(address, count);
+
+	for (Thread_t q = 0; q < OS_THREADS; ++q)
+	{
+		int entry = os_wait_entry(q, address);
+		if (entry < 0)
+		{
+			continue;
+		}
+
+		if (os_threads[q].block_object == (unsigned long) address)
+		{
+			/* Thread will be woken by wake of target */
+			os_threads[q].block_object = (unsigned long) target;
+		}
+		else
+		{
+			/* Wait list of wait_objects() is not rewritten, wake it instead */
+			os_notify_waiter(q, entry, E_OK);
+		}
+		woken++;
+	}
+
+	return woken;
+}
+
+/** @} */
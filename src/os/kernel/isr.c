@@ -12,40 +12,218 @@
  * Never perform direct calls into kernel other than methods listed in this group. These
  * methods are not reentrant and calling them from within interrupt handler may corrupt 
  * kernel internal state.
+ *
+ * Routines in this group don't touch kernel state. They post requests into a ring
+ * which kernel drains once no interrupt service routine is executing. Then
+ * requests are executed the same way syscalls are, including the decision
+ * whether woken thread shall preempt the running one.
  * @{ 
  */
 #include <cmrx/ipc/isr.h>
 #include <conf/kernel.h>
 #include <cmrx/os/runtime.h>
 #include <cmrx/os/sched.h>
+#include <cmrx/os/signal.h>
+#include <cmrx/os/futex.h>
+#include <cmrx/os/event.h>
+#include <cmrx/os/notify.h>
+#include <cmrx/os/mqueue.h>
+#include <cmrx/os/isr.h>
 #include <cmrx/os/arch/sched.h>
 
-void isr_kill(Thread_t thread_id, uint32_t signal)
+/** Kinds of requests interrupt service routines can post */
+enum OS_isr_request_type {
+	ISR_REQUEST_KILL,
+	ISR_REQUEST_THREAD_CONTINUE,
+	ISR_REQUEST_FUTEX_WAKE,
+	ISR_REQUEST_EVENT_GROUP_SET,
+	ISR_REQUEST_NOTIFY_GIVE,
+	ISR_REQUEST_SEM_GIVE,
+	ISR_REQUEST_MQUEUE_SEND
+};
+
+/** Request posted by interrupt service routine. */
+struct OS_isr_request_t {
+	/** Signal number, futex address, event flags or message slot, depending on request type */
+	uint32_t arg;
+	/** Type of request, see @ref OS_isr_request_type */
+	uint8_t type;
+	/** Thread, event group or message queue request applies to */
+	uint8_t target;
+	/** Amount of threads woken up by futex wake request, generation of
+	 * message queue for message queue send request
+	 */
+	uint8_t count;
+	/** Slot contains complete request */
+	volatile uint8_t ready;
+};
+
+/** Ring of requests posted by interrupt service routines.
+ * Any amount of interrupt service routines can post requests. Only kernel
+ * consumes them. Slots are reserved by atomic increment of @ref os_isr_reserved.
+ */
+static struct OS_isr_request_t os_isr_requests[OS_ISR_REQUESTS];
+
+/** Amount of slots ever reserved by producers. Free running. */
+static volatile uint32_t os_isr_reserved = 0;
+
+/** Amount of slots ever consumed by kernel. Free running. */
+static volatile uint32_t os_isr_consumed = 0;
+
+/** Post request to kernel.
+ * @param type type of request
+ * @param target thread or event group request applies to
+ * @param arg signal number, futex address or event flags
+ * @param count amount of threads woken up or generation of message queue
+ * @returns E_OK if request was posted, E_BUSY if request ring is full
+ */
+static int isr_post(enum OS_isr_request_type type, uint8_t target, uint32_t arg, uint8_t count)
 {
-	if (thread_id < OS_THREADS
-			&& signal < 32
-			&& (
-				os_threads[thread_id].state == THREAD_STATE_READY
-				|| os_threads[thread_id].state == THREAD_STATE_RUNNING
-				|| os_threads[thread_id].state == THREAD_STATE_STOPPED
-			   )
-	   )
+	uint32_t slot;
+
+	do {
+		slot = os_isr_reserved;
+		if (slot - os_isr_consumed >= OS_ISR_REQUESTS)
+		{
+			return E_BUSY;
+		}
+	} while (!os_atomic_compare_exchange(&os_isr_reserved, slot, slot + 1));
+
+	struct OS_isr_request_t * request = &os_isr_requests[slot % OS_ISR_REQUESTS];
+	request->type = type;
+	request->target = target;
+	request->arg = arg;
+	request->count = count;
+	/* Request content must be visible before it is marked ready */
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	request->ready = 1;
+
+	os_pend_isr_requests();
+	return E_OK;
+}
+
+void os_isr_drain(void)
+{
+	while (os_isr_consumed != os_isr_reserved)
 	{
-		os_threads[thread_id].signals |= 1 << signal;
-		if (os_threads[thread_id].state == THREAD_STATE_STOPPED)
+		struct OS_isr_request_t * slot = &os_isr_requests[os_isr_consumed % OS_ISR_REQUESTS];
+		if (!slot->ready)
 		{
-			os_threads[thread_id].state = THREAD_STATE_READY;
+			/* Producer reserved slot but didn't finish it yet */
+			break;
 		}
-		/* this stuff is dodgy and would deserve complete 
-		 * rewrite to be more robust and more predictable */
-		if (os_threads[thread_id].priority > os_threads[os_get_current_thread()].priority)
+
+		/* Don't read request content before it is marked ready */
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		struct OS_isr_request_t request = *slot;
+		slot->ready = 0;
+		/* Slot must be copied out before producers can reuse it */
+		__atomic_thread_fence(__ATOMIC_RELEASE);
+		os_isr_consumed++;
+
+		switch (request.type)
 		{
-			if (schedule_context_switch(os_get_current_thread(), thread_id))
-			{
-				os_set_current_thread(thread_id);
-			}
+			case ISR_REQUEST_KILL:
+				os_kill(request.target, request.arg);
+				break;
+
+			case ISR_REQUEST_THREAD_CONTINUE:
+				os_thread_continue(request.target);
+				break;
+
+			case ISR_REQUEST_FUTEX_WAKE:
+				os_futex_wake((uint32_t *) request.arg, request.count);
+				break;
+
+			case ISR_REQUEST_EVENT_GROUP_SET:
+				os_event_group_set(request.target, request.arg);
+				break;
+
+			case ISR_REQUEST_NOTIFY_GIVE:
+				os_notify_give(request.target, request.arg);
+				break;
+
+			case ISR_REQUEST_SEM_GIVE:
+				os_sem_give((uint32_t *) request.arg);
+				break;
+
+			case ISR_REQUEST_MQUEUE_SEND:
+				os_mqueue_post_checked(request.target, request.arg, request.count);
+				break;
 		}
 	}
 }
 
+int isr_kill(Thread_t thread_id, uint32_t signal)
+{
+	if (thread_id >= OS_THREADS || signal >= 32)
+	{
+		return E_INVALID;
+	}
+
+	return isr_post(ISR_REQUEST_KILL, thread_id, signal, 0);
+}
+
+int isr_thread_continue(Thread_t thread_id)
+{
+	if (thread_id >= OS_THREADS)
+	{
+		return E_INVALID;
+	}
+
+	return isr_post(ISR_REQUEST_THREAD_CONTINUE, thread_id, 0, 0);
+}
+
+int isr_futex_wake(uint32_t * address, uint8_t count)
+{
+	return isr_post(ISR_REQUEST_FUTEX_WAKE, 0, (uint32_t) address, count);
+}
+
+int isr_event_group_set(int group, uint32_t bits)
+{
+	if (group < 0 || group >= OS_EVENT_GROUPS)
+	{
+		return E_INVALID;
+	}
+
+	return isr_post(ISR_REQUEST_EVENT_GROUP_SET, group, bits, 0);
+}
+
+int isr_notify_give(Thread_t thread_id, unsigned index)
+{
+	if (thread_id >= OS_THREADS || index >= OS_THREAD_NOTIFICATIONS)
+	{
+		return E_INVALID;
+	}
+
+	return isr_post(ISR_REQUEST_NOTIFY_GIVE, thread_id, index, 0);
+}
+
+int isr_sem_give(sem_t * sem)
+{
+	return isr_post(ISR_REQUEST_SEM_GIVE, 0, (uint32_t) &sem->value, 0);
+}
+
+int isr_mqueue_send(int queue, const void * message)
+{
+	if (queue < 0 || queue >= OS_MQUEUES)
+	{
+		return E_INVALID;
+	}
+
+	/* Message is copied right away, only queueing is deferred */
+	int slot = os_mqueue_reserve(queue, message);
+	if (slot < 0)
+	{
+		return -slot;
+	}
+
+	int rv = isr_post(ISR_REQUEST_MQUEUE_SEND, queue, slot, os_mqueue_generation(queue));
+	if (rv != E_OK)
+	{
+		os_mqueue_cancel(queue, slot);
+	}
+	return rv;
+}
+
 /** @} */
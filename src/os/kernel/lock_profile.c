@@ -0,0 +1,121 @@
+/** @addtogroup os_lock_profile
+ * @{
+ */
+#include <cmrx/os/lock_profile.h>
+#include <cmrx/ipc/mutex.h>
+#include <cmrx/os/sched.h>
+#include <cmrx/os/arch/sched.h>
+#include <conf/kernel.h>
+
+#ifdef KERNEL_HAS_LOCK_PROFILE
+
+/** Pending wait of thread. */
+struct OS_lock_wait_t {
+	uint32_t lock;              ///< address thread sleeps on, 0 if none
+	uint32_t since;             ///< time of first sleep
+};
+
+/** Lock profile, read by debugger. */
+struct OS_lock_profile_t os_lock_profile = {
+	.magic = LOCK_PROFILE_MAGIC,
+	.version = LOCK_PROFILE_VERSION,
+	.record_size = sizeof(struct OS_lock_stat_t),
+	.entries = OS_LOCK_PROFILE_ENTRIES,
+#ifndef __ARM_ARCH_6M__
+	.cycles = 1,
+#endif
+};
+
+/** Sleeps in progress, per thread. */
+static struct OS_lock_wait_t os_lock_waits[OS_THREADS];
+
+/** Find statistics entry for lock.
+ * Allocates new entry if lock has none yet.
+ * @returns address of entry or NULL if table is full
+ */
+static struct OS_lock_stat_t * os_lock_stat_find(uint32_t lock)
+{
+	for (int q = 0; q < OS_LOCK_PROFILE_ENTRIES; ++q)
+	{
+		struct OS_lock_stat_t * stat = &os_lock_profile.stats[q];
+		if (stat->lock == 0)
+		{
+			stat->lock = lock;
+			stat->owner = 0xFF;
+			return stat;
+		}
+
+		if (stat->lock == lock)
+		{
+			return stat;
+		}
+	}
+
+	os_lock_profile.dropped++;
+	return NULL;
+}
+
+void os_lock_profile_wait(Thread_t thread_id, const void * lock)
+{
+	struct OS_lock_stat_t * stat = os_lock_stat_find((uint32_t) lock);
+	if (stat == NULL)
+	{
+		return;
+	}
+
+	stat->sleeps++;
+	stat->waiters |= 1 << thread_id;
+
+	/* Wait time spans all sleeps of single acquisition */
+	if (os_lock_waits[thread_id].lock != (uint32_t) lock)
+	{
+		os_lock_waits[thread_id].lock = (uint32_t) lock;
+		os_lock_waits[thread_id].since = os_cycle_count();
+	}
+}
+
+int os_lock_profile_event(const void * lock, unsigned event)
+{
+	Thread_t thread_id = os_get_current_thread();
+	uint32_t now = os_cycle_count();
+
+	if (event != LOCK_PROFILE_ACQUIRED && event != LOCK_PROFILE_RELEASED)
+	{
+		return E_INVALID;
+	}
+
+	struct OS_lock_stat_t * stat = os_lock_stat_find((uint32_t) lock);
+	if (stat == NULL)
+	{
+		return E_OK;
+	}
+
+	if (event == LOCK_PROFILE_ACQUIRED)
+	{
+		stat->acquisitions++;
+		stat->acquired = now;
+		stat->owner = thread_id;
+
+		struct OS_lock_wait_t * wait = &os_lock_waits[thread_id];
+		if (wait->lock == (uint32_t) lock)
+		{
+			stat->contended++;
+			stat->wait_time += now - wait->since;
+			wait->lock = 0;
+		}
+	}
+	else if (stat->owner == thread_id)
+	{
+		uint32_t held = now - stat->acquired;
+		if (held > stat->hold_max)
+		{
+			stat->hold_max = held;
+		}
+	}
+
+	return E_OK;
+}
+
+#endif
+
+/** @} */
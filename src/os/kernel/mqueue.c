@@ -0,0 +1,548 @@
+/** @addtogroup os_mqueue
+ * @{
+ */
+#include <cmrx/os/mqueue.h>
+#include <cmrx/os/notify.h>
+#include <cmrx/os/runtime.h>
+#include <cmrx/os/sched.h>
+#include <cmrx/os/mpu.h>
+#include <cmrx/os/arch/mpu.h>
+#include <cmrx/os/arch/sched.h>
+#include <cmrx/ipc/mqueue.h>
+#include <cmrx/defines.h>
+#include <conf/kernel.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if OS_MQUEUE_SLOTS > 32
+#	error "At most 32 message slots are supported"
+#endif
+
+#if (OS_MQUEUE_SLOT_SIZE & (OS_MQUEUE_SLOT_SIZE - 1)) != 0 || OS_MQUEUE_SLOT_SIZE < 32
+#	error "Size of message slot has to be power of two, at least 32 bytes"
+#endif
+
+#if defined(__ARM_ARCH_6M__) && OS_MQUEUE_SLOT_SIZE < 256
+#	error "ARMv6-M MPU can't map message slots smaller than 256 bytes"
+#endif
+
+/** Marks end of list of queued slots */
+#define MQUEUE_NO_SLOT			0xFF
+
+/** Receiver wants message mapped instead of copied */
+#define MQUEUE_WAIT_MAP			1
+
+/** Message queue kernel object.
+ * Receivers blocked on queue wait for address of queue, senders wait for
+ * address of @ref depth.
+ */
+struct OS_mqueue_t {
+	/** Slots taken by queue: queued, mapped by receivers or being filled
+	 * by interrupt service routines. Modified atomically.
+	 */
+	volatile uint32_t used;
+	/** Size of message */
+	uint16_t size;
+	/** Maximal amount of slots taken at once */
+	uint8_t depth;
+	/** Oldest queued message, MQUEUE_NO_SLOT if queue is empty */
+	uint8_t head;
+	/** Newest queued message */
+	uint8_t tail;
+	/** Process owning the queue */
+	Process_t owner;
+	/** Incremented when queue is deleted. Tells requests posted by
+	 * interrupt service routines for deleted queue from requests for
+	 * queue which reuses its handle.
+	 */
+	uint8_t generation;
+	/** True if queue is in use */
+	bool allocated;
+};
+
+static struct OS_mqueue_t os_mqueues[OS_MQUEUES];
+
+/** Message slots. Each is aligned to its size, so it can be mapped by single MPU region. */
+static uint8_t os_mqueue_slots[OS_MQUEUE_SLOTS][OS_MQUEUE_SLOT_SIZE] __attribute__((aligned(OS_MQUEUE_SLOT_SIZE)));
+
+/** Next queued slot for each slot */
+static uint8_t os_mqueue_next[OS_MQUEUE_SLOTS];
+
+/** Queue each slot is taken by */
+static uint8_t os_mqueue_owner[OS_MQUEUE_SLOTS];
+
+/** Mask of free slots. Modified atomically, as interrupt service routines
+ * allocate slots too.
+ */
+static volatile uint32_t os_mqueue_free = (uint32_t) ((1ULL << OS_MQUEUE_SLOTS) - 1);
+
+/** Amount of slots reserved by existing queues */
+static unsigned os_mqueue_reserved = 0;
+
+/** Translate queue handle to kernel object.
+ * @param queue_id queue handle
+ * @returns address of queue or NULL if handle is not valid
+ */
+static struct OS_mqueue_t * os_mqueue_get(int queue_id)
+{
+	if (queue_id < 0 || queue_id >= OS_MQUEUES || !os_mqueues[queue_id].allocated)
+	{
+		return NULL;
+	}
+
+	return &os_mqueues[queue_id];
+}
+
+/** Take one slot out of queue's depth.
+ * @param queue message queue
+ * @returns true if queue has space for another message
+ */
+static bool os_mqueue_credit_take(struct OS_mqueue_t * queue)
+{
+	uint32_t used;
+	do {
+		used = queue->used;
+		if (used >= queue->depth)
+		{
+			return false;
+		}
+	} while (!os_atomic_compare_exchange(&queue->used, used, used + 1));
+
+	return true;
+}
+
+/** Return one slot to queue's depth.
+ * @param queue message queue
+ */
+static void os_mqueue_credit_return(struct OS_mqueue_t * queue)
+{
+	uint32_t used;
+	do {
+		used = queue->used;
+	} while (!os_atomic_compare_exchange(&queue->used, used, used - 1));
+}
+
+/** Allocate free slot.
+ * @returns index of slot or -1 if all slots are taken
+ */
+static int os_mqueue_slot_alloc(void)
+{
+	uint32_t free;
+	do {
+		free = os_mqueue_free;
+		if (free == 0)
+		{
+			return -1;
+		}
+	} while (!os_atomic_compare_exchange(&os_mqueue_free, free, free & (free - 1)));
+
+	return __builtin_ctz(free);
+}
+
+/** Return slot into pool of free slots.
+ * @param slot index of slot
+ */
+static void os_mqueue_slot_free(unsigned slot)
+{
+	uint32_t free;
+	do {
+		free = os_mqueue_free;
+	} while (!os_atomic_compare_exchange(&os_mqueue_free, free, free | (1 << slot)));
+}
+
+/** Find thread with highest priority blocked on object.
+ * @param object address of object
+ * @returns thread ID or OS_THREADS if nobody waits for object
+ */
+static Thread_t os_mqueue_waiter(const void * object)
+{
+	Thread_t candidate = OS_THREADS;
+
+	for (Thread_t q = 0; q < OS_THREADS; ++q)
+	{
+		if (os_threads[q].state == THREAD_STATE_WAITING
+				&& os_threads[q].block_object == (unsigned long) object
+				&& (candidate == OS_THREADS || os_threads[q].priority < os_threads[candidate].priority))
+		{
+			candidate = q;
+		}
+	}
+
+	return candidate;
+}
+
+/** Take oldest message out of queue.
+ * @param queue non-empty message queue
+ * @returns index of slot holding the message
+ */
+static unsigned os_mqueue_pop(struct OS_mqueue_t * queue)
+{
+	unsigned slot = queue->head;
+	queue->head = os_mqueue_next[slot];
+	return slot;
+}
+
+/** Return slot taken by queue.
+ * If any sender waits for space in queue, then its message is accepted.
+ * @param queue message queue
+ * @param slot index of slot
+ */
+static void os_mqueue_slot_release(struct OS_mqueue_t * queue, unsigned slot)
+{
+	os_mqueue_slot_free(slot);
+	os_mqueue_credit_return(queue);
+
+	Thread_t sender = os_mqueue_waiter(&queue->depth);
+	if (sender != OS_THREADS)
+	{
+		int queue_id = queue - os_mqueues;
+		int new_slot = os_mqueue_reserve(queue_id, (const void *) os_threads[sender].wait_list[0].mask);
+		if (new_slot >= 0)
+		{
+			os_mqueue_post(queue_id, new_slot);
+			os_notify_waiter(sender, 0, E_OK);
+		}
+	}
+}
+
+/** Release message mapped by thread.
+ * @param thread_id thread
+ * @returns true if thread had message mapped
+ */
+static bool os_mqueue_unmap(Thread_t thread_id)
+{
+	uintptr_t base = (uintptr_t) os_threads[thread_id].mpu_window.base;
+	uintptr_t pool = (uintptr_t) os_mqueue_slots;
+
+	if (base < pool || base >= pool + sizeof(os_mqueue_slots))
+	{
+		return false;
+	}
+
+	unsigned slot = (base - pool) / OS_MQUEUE_SLOT_SIZE;
+	os_thread_map_window(thread_id, NULL, 0, MPU_NONE);
+	os_mqueue_slot_release(&os_mqueues[os_mqueue_owner[slot]], slot);
+	return true;
+}
+
+/** Hand message over to receiver.
+ * Message is either copied into receiver's buffer and its slot is returned
+ * to the queue, or the slot is mapped to receiver.
+ * @param queue message queue
+ * @param thread_id receiving thread
+ * @param destination buffer or place to store address of mapped message
+ * @param map true if message shall be mapped
+ * @param slot index of slot holding the message
+ * @returns E_OK if message was handed over, error code if slot can't be
+ * mapped. Slot stays with caller then.
+ */
+static int os_mqueue_deliver(struct OS_mqueue_t * queue, Thread_t thread_id, void * destination, bool map, unsigned slot)
+{
+	if (map)
+	{
+		int rv = os_thread_map_window(thread_id, os_mqueue_slots[slot], OS_MQUEUE_SLOT_SIZE, MPU_R);
+		if (rv != E_OK)
+		{
+			return rv;
+		}
+		*(const void **) destination = os_mqueue_slots[slot];
+	}
+	else
+	{
+		memcpy(destination, os_mqueue_slots[slot], queue->size);
+		os_mqueue_slot_release(queue, slot);
+	}
+
+	return E_OK;
+}
+
+int os_mqueue_reserve(int queue_id, const void * message)
+{
+	struct OS_mqueue_t * queue = os_mqueue_get(queue_id);
+	if (queue == NULL)
+	{
+		return -E_INVALID;
+	}
+
+	if (!os_mqueue_credit_take(queue))
+	{
+		return -E_BUSY;
+	}
+
+	/* Can't fail as queues never take more slots than they reserved */
+	int slot = os_mqueue_slot_alloc();
+	if (slot < 0)
+	{
+		os_mqueue_credit_return(queue);
+		return -E_BUSY;
+	}
+
+	os_mqueue_owner[slot] = queue_id;
+	memcpy(os_mqueue_slots[slot], message, queue->size);
+	return slot;
+}
+
+void os_mqueue_cancel(int queue_id, unsigned slot)
+{
+	os_mqueue_slot_free(slot);
+	os_mqueue_credit_return(&os_mqueues[queue_id]);
+}
+
+uint8_t os_mqueue_generation(int queue_id)
+{
+	return os_mqueues[queue_id].generation;
+}
+
+void os_mqueue_post_checked(int queue_id, unsigned slot, uint8_t generation)
+{
+	struct OS_mqueue_t * queue = os_mqueue_get(queue_id);
+	if (queue == NULL || queue->generation != generation)
+	{
+		/* Queue got deleted while interrupt service routine filled the
+		 * slot. Slot was released by os_mqueue_delete() already.
+		 */
+		return;
+	}
+
+	os_mqueue_post(queue_id, slot);
+}
+
+void os_mqueue_post(int queue_id, unsigned slot)
+{
+	struct OS_mqueue_t * queue = &os_mqueues[queue_id];
+
+	Thread_t receiver = os_mqueue_waiter(queue);
+	if (receiver != OS_THREADS)
+	{
+		struct OS_wait_entry_t * wait = &os_threads[receiver].wait_list[0];
+		int rv = os_mqueue_deliver(queue, receiver, (void *) wait->mask, wait->flags & MQUEUE_WAIT_MAP, slot);
+		os_notify_waiter(receiver, 0, rv);
+		if (rv == E_OK)
+		{
+			return;
+		}
+		/* Receive failed, message is queued for someone else */
+	}
+
+	os_mqueue_next[slot] = MQUEUE_NO_SLOT;
+	if (queue->head == MQUEUE_NO_SLOT)
+	{
+		queue->head = slot;
+	}
+	else
+	{
+		os_mqueue_next[queue->tail] = slot;
+	}
+	queue->tail = slot;
+}
+
+void os_mqueue_thread_exit(Thread_t thread_id)
+{
+	os_mqueue_unmap(thread_id);
+}
+
+int os_mqueue_create(unsigned depth, unsigned message_size)
+{
+	if (depth == 0 || message_size == 0 || message_size > OS_MQUEUE_SLOT_SIZE)
+	{
+		return -E_INVALID;
+	}
+
+	if (os_mqueue_reserved + depth > OS_MQUEUE_SLOTS)
+	{
+		return -E_OUT_OF_RANGE;
+	}
+
+	for (int q = 0; q < OS_MQUEUES; ++q)
+	{
+		struct OS_mqueue_t * queue = &os_mqueues[q];
+		if (!queue->allocated)
+		{
+			queue->used = 0;
+			queue->size = message_size;
+			queue->depth = depth;
+			queue->head = MQUEUE_NO_SLOT;
+			queue->tail = MQUEUE_NO_SLOT;
+			queue->owner = os_get_current_process();
+			queue->allocated = true;
+			os_mqueue_reserved += depth;
+			return q;
+		}
+	}
+
+	return -E_OUT_OF_RANGE;
+}
+
+int os_mqueue_delete(int queue_id)
+{
+	struct OS_mqueue_t * queue = os_mqueue_get(queue_id);
+	if (queue == NULL || queue->owner != os_get_current_process())
+	{
+		return E_INVALID;
+	}
+
+	queue->allocated = false;
+
+	while (os_notify_object_value(queue, E_INVALID))
+		;
+
+	while (os_notify_object_value(&queue->depth, E_INVALID))
+		;
+
+	while (queue->head != MQUEUE_NO_SLOT)
+	{
+		os_mqueue_slot_free(os_mqueue_pop(queue));
+	}
+
+	/* Mapped messages are revoked, so that their slots can be reserved again */
+	for (Thread_t q = 0; q < OS_THREADS; ++q)
+	{
+		uintptr_t base = (uintptr_t) os_threads[q].mpu_window.base;
+		uintptr_t pool = (uintptr_t) os_mqueue_slots;
+		if (base >= pool && base < pool + sizeof(os_mqueue_slots)
+				&& os_mqueue_owner[(base - pool) / OS_MQUEUE_SLOT_SIZE] == queue_id)
+		{
+			os_thread_map_window(q, NULL, 0, MPU_NONE);
+			os_mqueue_slot_free((base - pool) / OS_MQUEUE_SLOT_SIZE);
+		}
+	}
+
+	/* Remaining slots of queue are being filled by interrupt service
+	 * routines. Their requests get dropped once drained.
+	 */
+	for (unsigned slot = 0; slot < OS_MQUEUE_SLOTS; ++slot)
+	{
+		if ((os_mqueue_free & (1 << slot)) == 0 && os_mqueue_owner[slot] == queue_id)
+		{
+			os_mqueue_slot_free(slot);
+		}
+	}
+
+	queue->generation++;
+	os_mqueue_reserved -= queue->depth;
+	return E_OK;
+}
+
+int os_mqueue_send(int queue_id, const void * message, unsigned microseconds)
+{
+	struct OS_mqueue_t * queue = os_mqueue_get(queue_id);
+	if (queue == NULL)
+	{
+		return E_INVALID;
+	}
+
+	/* Message is read later again if sender has to wait for space */
+	if (!mpu_user_accessible(message, queue->size, false))
+	{
+		return E_INVALID_ADDRESS;
+	}
+
+	int slot = os_mqueue_reserve(queue_id, message);
+	if (slot >= 0)
+	{
+		os_mqueue_post(queue_id, slot);
+		return E_OK;
+	}
+
+	if (microseconds == 0)
+	{
+		return E_TIMEOUT;
+	}
+
+	struct OS_wait_entry_t * wait = &os_threads[os_get_current_thread()].wait_list[0];
+	wait->object = (unsigned long) &queue->depth;
+	wait->mask = (uint32_t) message;
+	int rv = os_wait_for_object_timeout(&queue->depth, microseconds);
+	if (rv != E_OK)
+	{
+		return rv;
+	}
+
+	/* This is returned if wait times out. If message is accepted,
+	 * then os_mqueue_slot_release() replaces it by E_OK.
+	 */
+	return E_TIMEOUT;
+}
+
+/** Common implementation of copying and mapping receive.
+ * @param queue_id handle of message queue
+ * @param destination buffer or place to store address of mapped message
+ * @param map true if message shall be mapped
+ * @param microseconds timeout
+ * @returns E_OK, E_TIMEOUT, E_INVALID, E_INVALID_ADDRESS or error code if
+ * message can't be mapped
+ */
+static int os_mqueue_receive_common(int queue_id, void * destination, bool map, unsigned microseconds)
+{
+	struct OS_mqueue_t * queue = os_mqueue_get(queue_id);
+	if (queue == NULL)
+	{
+		return E_INVALID;
+	}
+
+	/* Destination is written later again if receiver has to wait */
+	if (!mpu_user_accessible(destination, map ? sizeof(const void *) : queue->size, true))
+	{
+		return E_INVALID_ADDRESS;
+	}
+
+	Thread_t thread_id = os_get_current_thread();
+	if (map)
+	{
+		os_mqueue_unmap(thread_id);
+	}
+
+	if (queue->head != MQUEUE_NO_SLOT)
+	{
+		unsigned slot = os_mqueue_pop(queue);
+		int rv = os_mqueue_deliver(queue, thread_id, destination, map, slot);
+		if (rv != E_OK)
+		{
+			/* Message stays the oldest one in queue */
+			os_mqueue_next[slot] = queue->head;
+			if (queue->head == MQUEUE_NO_SLOT)
+			{
+				queue->tail = slot;
+			}
+			queue->head = slot;
+		}
+		return rv;
+	}
+
+	if (microseconds == 0)
+	{
+		return E_TIMEOUT;
+	}
+
+	struct OS_wait_entry_t * wait = &os_threads[thread_id].wait_list[0];
+	wait->object = (unsigned long) queue;
+	wait->mask = (uint32_t) destination;
+	wait->flags = map ? MQUEUE_WAIT_MAP : 0;
+	int rv = os_wait_for_object_timeout(queue, microseconds);
+	if (rv != E_OK)
+	{
+		return rv;
+	}
+
+	/* This is returned if wait times out. If message arrives,
+	 * then os_mqueue_post() replaces it by E_OK.
+	 */
+	return E_TIMEOUT;
+}
+
+int os_mqueue_receive(int queue_id, void * message, unsigned microseconds)
+{
+	return os_mqueue_receive_common(queue_id, message, false, microseconds);
+}
+
+int os_mqueue_receive_map(int queue_id, const void ** message, unsigned microseconds)
+{
+	return os_mqueue_receive_common(queue_id, message, true, microseconds);
+}
+
+int os_mqueue_release(void)
+{
+	return os_mqueue_unmap(os_get_current_thread()) ? E_OK : E_INVALID;
+}
+
+/** @} */
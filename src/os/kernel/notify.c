@@ -0,0 +1,254 @@
+/** @addtogroup os_notify
+ * @{
+ */
+#include <cmrx/os/notify.h>
+#include <cmrx/os/runtime.h>
+#include <cmrx/os/sched.h>
+#include <cmrx/os/timer.h>
+#include <cmrx/os/arch/sched.h>
+#include <conf/kernel.h>
+
+/** Check if thread waits for multiple objects.
+ * @param thread_id thread being examined
+ * @returns true if thread blocks in wait_objects()
+ */
+static bool os_waits_multiple(Thread_t thread_id)
+{
+	return os_threads[thread_id].block_object == (unsigned long) os_threads[thread_id].wait_list;
+}
+
+/** Find thread waiting for object.
+ * @param object address of object
+ * @param entry place to store index of wait entry of the thread found
+ * @returns ID of the highest priority thread waiting for object or OS_THREADS
+ * if there is no thread waiting for it.
+ */
+static Thread_t os_find_waiter(const void * object, int * entry)
+{
+	Thread_t candidate = OS_THREADS;
+
+	for (Thread_t q = 0; q < OS_THREADS; ++q)
+	{
+		int index = os_wait_entry(q, object);
+		if (index >= 0)
+		{
+			if (candidate == OS_THREADS || os_threads[q].priority < os_threads[candidate].priority)
+			{
+				candidate = q;
+				*entry = index;
+			}
+		}
+	}
+
+	return candidate;
+}
+
+int os_wait_entry(Thread_t thread_id, const void * object)
+{
+	struct OS_thread_t * thread = &os_threads[thread_id];
+
+	if (thread->state != THREAD_STATE_WAITING)
+	{
+		return -1;
+	}
+
+	if (thread->block_object == (unsigned long) object)
+	{
+		return 0;
+	}
+
+	if (os_waits_multiple(thread_id))
+	{
+		for (int q = 0; q < thread->wait_count; ++q)
+		{
+			if (thread->wait_list[q].object == (unsigned long) object)
+			{
+				return q;
+			}
+		}
+	}
+
+	return -1;
+}
+
+int os_wait_for_object(const void * object)
+{
+	Thread_t thread_id = os_get_current_thread();
+
+	os_threads[thread_id].block_object = (unsigned long) object;
+	os_threads[thread_id].state = THREAD_STATE_WAITING;
+	os_sched_yield();
+
+	return E_OK;
+}
+
+int os_wait_for_object_timeout(const void * object, unsigned microseconds)
+{
+	if (microseconds != WAIT_FOREVER)
+	{
+		int rv = os_set_timed_event(os_get_current_thread(), microseconds, TIMER_WAIT);
+		if (rv != E_OK)
+		{
+			return rv;
+		}
+	}
+	return os_wait_for_object(object);
+}
+
+int os_wait_for_objects_timeout(unsigned count, unsigned microseconds)
+{
+	struct OS_thread_t * thread = &os_threads[os_get_current_thread()];
+
+	thread->wait_count = count;
+	return os_wait_for_object_timeout(thread->wait_list, microseconds);
+}
+
+void os_wait_timeout_expired(Thread_t thread_id)
+{
+	if (os_threads[thread_id].state == THREAD_STATE_WAITING)
+	{
+		os_threads[thread_id].block_object = 0;
+		os_threads[thread_id].state = THREAD_STATE_READY;
+		os_sched_yield();
+	}
+}
+
+void os_notify_thread(Thread_t thread_id)
+{
+	/* Thread may have been waiting with timeout */
+	os_cancel_timed_event(thread_id, TIMER_WAIT);
+
+	os_threads[thread_id].block_object = 0;
+	os_threads[thread_id].state = THREAD_STATE_READY;
+	os_sched_yield();
+}
+
+void os_notify_waiter(Thread_t thread_id, int entry, int value)
+{
+	/* Thread waiting for multiple objects learns which one got notified */
+	os_set_syscall_return_value(thread_id, os_waits_multiple(thread_id) ? entry : value);
+	os_notify_thread(thread_id);
+}
+
+bool os_notify_object(const void * object)
+{
+	int entry = 0;
+	Thread_t thread_id = os_find_waiter(object, &entry);
+
+	if (thread_id == OS_THREADS)
+	{
+		return false;
+	}
+
+	if (os_waits_multiple(thread_id))
+	{
+		os_set_syscall_return_value(thread_id, entry);
+	}
+	os_notify_thread(thread_id);
+	return true;
+}
+
+bool os_notify_object_value(const void * object, int value)
+{
+	int entry = 0;
+	Thread_t thread_id = os_find_waiter(object, &entry);
+
+	if (thread_id == OS_THREADS)
+	{
+		return false;
+	}
+
+	os_notify_waiter(thread_id, entry, value);
+	return true;
+}
+
+bool os_notify_object_deleted(const void * object, int value)
+{
+	int entry = 0;
+	Thread_t thread_id = os_find_waiter(object, &entry);
+
+	if (thread_id == OS_THREADS)
+	{
+		return false;
+	}
+
+	os_set_syscall_return_value(thread_id, os_waits_multiple(thread_id) ? -E_DELETED : value);
+	os_notify_thread(thread_id);
+	return true;
+}
+
+/** Take value out of notification counter.
+ * @param counter notification counter
+ * @param clear if true, counter is cleared, otherwise it is decremented
+ * @returns value of counter before it was taken
+ */
+static uint32_t os_notify_counter_take(uint32_t * counter, bool clear)
+{
+	uint32_t value = *counter;
+
+	if (value != 0)
+	{
+		*counter = clear ? 0 : value - 1;
+	}
+
+	return value;
+}
+
+int os_notify_give(Thread_t thread_id, unsigned index)
+{
+	if (thread_id >= OS_THREADS || index >= OS_THREAD_NOTIFICATIONS
+			|| os_threads[thread_id].state == THREAD_STATE_EMPTY
+			|| os_threads[thread_id].state == THREAD_STATE_FINISHED)
+	{
+		return E_INVALID;
+	}
+
+	struct OS_thread_t * thread = &os_threads[thread_id];
+	uint32_t * counter = &thread->notifications[index];
+	(*counter)++;
+
+	int entry = os_wait_entry(thread_id, counter);
+	if (entry >= 0)
+	{
+		if (thread->block_object == (unsigned long) counter)
+		{
+			/* Owner blocks in notify_take(), hand the value over directly */
+			int value = os_notify_counter_take(counter, thread->wait_list[0].flags);
+			os_notify_waiter(thread_id, entry, value);
+		}
+		else
+		{
+			os_notify_waiter(thread_id, entry, 0);
+		}
+	}
+
+	return E_OK;
+}
+
+int os_notify_take(unsigned index, bool clear, unsigned microseconds)
+{
+	if (index >= OS_THREAD_NOTIFICATIONS)
+	{
+		return -E_INVALID;
+	}
+
+	struct OS_thread_t * thread = &os_threads[os_get_current_thread()];
+	uint32_t * counter = &thread->notifications[index];
+
+	uint32_t value = os_notify_counter_take(counter, clear);
+	if (value != 0 || microseconds == 0)
+	{
+		return value;
+	}
+
+	thread->wait_list[0].object = (unsigned long) counter;
+	thread->wait_list[0].flags = clear;
+	os_wait_for_object_timeout(counter, microseconds);
+
+	/* This is returned if wait times out. If notification is given,
+	 * then os_notify_give() replaces it by value of counter.
+	 */
+	return 0;
+}
+
+/** @} */
@@ -5,8 +5,30 @@
 #include <cmrx/os/syscall.h>
 #include <cmrx/os/syscalls.h>
 #include <cmrx/os/rpc.h>
+#include <cmrx/os/rpc_stats.h>
 #include <arch/sysenter.h>
 #include <cmrx/os/sched.h>
+#include <cmrx/os/notify.h>
+#include <cmrx/os/signal.h>
+#include <cmrx/os/arch/sched.h>
+#include <cmrx/os/arch/rpc.h>
+#include <cmrx/os/timer.h>
+#include <conf/kernel.h>
+
+/** Pool of asynchronous RPC requests. */
+static struct OS_RPC_request_t os_rpc_requests[OS_RPC_REQUESTS];
+
+/** Sequence number assigned to the next queued request. */
+static uint32_t os_rpc_request_sequence;
+
+/** Build completion token out of request slot. */
+#define RPC_REQUEST_TOKEN(slot, sequence)	((int) ((((sequence) & 0x7FFFFFU) << 8) | (slot)))
+
+/** Extract request slot number out of completion token. */
+#define RPC_REQUEST_SLOT(token)				((unsigned) (token) & 0xFFU)
+
+/** Extract sequence number out of completion token. */
+#define RPC_REQUEST_SEQUENCE(token)			(((unsigned) (token) >> 8) & 0x7FFFFFU)
 
 /// @cond IGNORE
 /// This is documented in the Kernel API group
@@ -14,6 +36,11 @@ __SYSCALL void rpc_return()
 {
 	__SVC(SYSCALL_RPC_RETURN);
 }
+
+__SYSCALL void rpc_async_return()
+{
+	__SVC(SYSCALL_RPC_ASYNC_RETURN);
+}
 /// @endcond
 
 Process_t get_vtable_process(VTable_t * vtable)
@@ -37,7 +64,7 @@ bool rpc_stack_push(Process_t process_id)
 {
 	Thread_t thread_id = os_get_current_thread();
 	uint8_t depth = os_threads[thread_id].rpc_stack[0];
-	if (depth < 8)
+	if (depth < OS_RPC_MAX_DEPTH)
 	{
 		os_threads[thread_id].rpc_stack[depth + 1] = process_id;
 		os_threads[thread_id].rpc_stack[0]++;
@@ -72,5 +99,298 @@ Process_t rpc_stack_top()
 	return E_VTABLE_UNKNOWN;
 }
 
+int os_rpc_request_submit(RPC_Service_t * service, unsigned method, const uint32_t * args, uint8_t signal, uint8_t flags)
+{
+	Process_t process_id = get_vtable_process(service->vtable);
+	if (process_id == E_VTABLE_UNKNOWN)
+	{
+		return -E_INVALID_ADDRESS;
+	}
+
+	unsigned pending = 0;
+	for (int q = 0; q < OS_RPC_REQUESTS; ++q)
+	{
+		struct OS_RPC_request_t * request = &os_rpc_requests[q];
+		if (request->state == RPC_REQUEST_PENDING && request->process == process_id)
+		{
+			if ((flags & RPC_REQUEST_FLAG_NOTIFY) && (request->flags & RPC_REQUEST_FLAG_NOTIFY)
+					&& request->service == service && request->method == method
+					&& request->args[0] == args[0] && request->args[1] == args[1]
+					&& request->args[2] == args[2] && request->args[3] == args[3])
+			{
+				/* Same notification is already waiting, merge them. */
+				return RPC_REQUEST_TOKEN(q, request->sequence);
+			}
+			pending++;
+		}
+	}
+
+	if (pending >= OS_RPC_QUEUE_DEPTH)
+	{
+		return -E_BUSY;
+	}
+
+	for (int q = 0; q < OS_RPC_REQUESTS; ++q)
+	{
+		struct OS_RPC_request_t * request = &os_rpc_requests[q];
+		if (request->state == RPC_REQUEST_FREE)
+		{
+			request->service = service;
+			request->method = method;
+			for (int w = 0; w < 4; ++w)
+			{
+				request->args[w] = args[w];
+			}
+			request->retval = 0;
+			request->sequence = os_rpc_request_sequence++;
+			request->process = process_id;
+			request->caller = os_get_current_thread();
+			request->server = OS_THREADS;
+			request->signal = signal;
+			request->flags = flags;
+			request->state = RPC_REQUEST_PENDING;
+
+			os_notify_object(&os_processes[process_id]);
+
+			return RPC_REQUEST_TOKEN(q, request->sequence);
+		}
+	}
+
+	return -E_BUSY;
+}
+
+int os_rpc_request_call(RPC_Service_t * service, unsigned method, const uint32_t * args)
+{
+	int token = os_rpc_request_submit(service, method, args, RPC_NO_SIGNAL, RPC_REQUEST_FLAG_BLOCKING);
+	if (token < 0)
+	{
+		return token;
+	}
+
+	return os_wait_for_object(&os_rpc_requests[RPC_REQUEST_SLOT(token)]);
+}
+
+struct OS_RPC_request_t * os_rpc_request_fetch(Process_t process_id, Thread_t server)
+{
+	struct OS_RPC_request_t * oldest = NULL;
+
+	for (int q = 0; q < OS_RPC_REQUESTS; ++q)
+	{
+		struct OS_RPC_request_t * request = &os_rpc_requests[q];
+		if (request->state == RPC_REQUEST_PENDING && request->process == process_id)
+		{
+			if (oldest == NULL || (int32_t) (request->sequence - oldest->sequence) < 0)
+			{
+				oldest = request;
+			}
+		}
+	}
+
+	if (oldest != NULL)
+	{
+		oldest->state = RPC_REQUEST_RUNNING;
+		oldest->server = server;
+	}
+
+	return oldest;
+}
+
+void os_rpc_request_complete(Thread_t server, int retval)
+{
+	for (int q = 0; q < OS_RPC_REQUESTS; ++q)
+	{
+		struct OS_RPC_request_t * request = &os_rpc_requests[q];
+		if (request->state == RPC_REQUEST_RUNNING && request->server == server)
+		{
+			request->retval = retval;
+			request->state = RPC_REQUEST_DONE;
+
+			enum ThreadState caller_state = os_threads[request->caller].state;
+			if (caller_state == THREAD_STATE_EMPTY || caller_state == THREAD_STATE_FINISHED
+					|| (request->flags & RPC_REQUEST_FLAG_NOTIFY))
+			{
+				/* Nobody will ever collect the result. */
+				request->state = RPC_REQUEST_FREE;
+			}
+			else if (request->flags & RPC_REQUEST_FLAG_BLOCKING)
+			{
+				/* Caller is still waiting inside the syscall, hand over
+				 * the return value directly.
+				 */
+				os_set_syscall_return_value(request->caller, retval);
+				request->state = RPC_REQUEST_FREE;
+				os_notify_object(request);
+			}
+			else if (request->signal < 32)
+			{
+				os_kill(request->caller, request->signal);
+			}
+			return;
+		}
+	}
+}
+
+int os_rpc_request_wait(void)
+{
+	return os_wait_for_object(&os_processes[os_get_current_process()]);
+}
+
+/** Translate completion token to request made by calling thread.
+ * @param token completion token
+ * @returns request identified by token or NULL if token is not valid
+ */
+static struct OS_RPC_request_t * os_rpc_request_get(int token)
+{
+	unsigned slot = RPC_REQUEST_SLOT(token);
+
+	if (token < 0 || slot >= OS_RPC_REQUESTS)
+	{
+		return NULL;
+	}
+
+	struct OS_RPC_request_t * request = &os_rpc_requests[slot];
+	if (request->state == RPC_REQUEST_FREE
+			|| request->caller != os_get_current_thread()
+			|| (request->sequence & 0x7FFFFFU) != RPC_REQUEST_SEQUENCE(token))
+	{
+		return NULL;
+	}
+
+	return request;
+}
+
+int os_rpc_poll(int token)
+{
+	struct OS_RPC_request_t * request = os_rpc_request_get(token);
+
+	if (request == NULL)
+	{
+		return E_INVALID;
+	}
+
+	if (request->state != RPC_REQUEST_DONE)
+	{
+		return E_BUSY;
+	}
+
+	return E_OK;
+}
+
+int os_rpc_result(int token)
+{
+	struct OS_RPC_request_t * request = os_rpc_request_get(token);
+
+	if (request == NULL || request->state != RPC_REQUEST_DONE)
+	{
+		return -E_INVALID;
+	}
+
+	request->state = RPC_REQUEST_FREE;
+	return request->retval;
+}
+
+int os_rpc_deadline_set(uint32_t * frame, unsigned microseconds)
+{
+	Thread_t thread_id = os_get_current_thread();
+	struct OS_thread_t * thread = &os_threads[thread_id];
+
+	if (thread->rpc_deadline_frame != NULL)
+	{
+		return E_BUSY;
+	}
+
+	int rv = os_set_timed_event(thread_id, microseconds, TIMER_DEADLINE);
+	if (rv != E_OK)
+	{
+		return rv;
+	}
+
+	thread->rpc_deadline_frame = frame;
+	thread->rpc_deadline_sequence = os_rpc_request_sequence;
+	thread->rpc_deadline_depth = thread->rpc_stack[0];
+
+	return E_OK;
+}
+
+void os_rpc_deadline_clear(uint32_t * frame)
+{
+	Thread_t thread_id = os_get_current_thread();
+	struct OS_thread_t * thread = &os_threads[thread_id];
+
+	if (thread->rpc_deadline_frame == frame)
+	{
+		os_cancel_timed_event(thread_id, TIMER_DEADLINE);
+		thread->rpc_deadline_frame = NULL;
+	}
+}
+
+void os_rpc_deadline_expired(Thread_t thread_id)
+{
+	struct OS_thread_t * thread = &os_threads[thread_id];
+	uint32_t * frame = thread->rpc_deadline_frame;
+
+	if (frame == NULL)
+	{
+		return;
+	}
+
+	thread->rpc_deadline_frame = NULL;
+
+	/* Results of queued calls made from within the aborted call
+	 * can't be delivered anymore. */
+	for (int q = 0; q < OS_RPC_REQUESTS; ++q)
+	{
+		struct OS_RPC_request_t * request = &os_rpc_requests[q];
+		if (request->state != RPC_REQUEST_FREE && request->caller == thread_id
+				&& (int32_t) (request->sequence - thread->rpc_deadline_sequence) >= 0)
+		{
+			request->flags = RPC_REQUEST_FLAG_NOTIFY;
+		}
+	}
+
+	while (thread->rpc_stack[0] > thread->rpc_deadline_depth)
+	{
+		Process_t process_id = thread->rpc_stack[thread->rpc_stack[0]];
+		os_rpc_stats_leave(thread_id, true);
+		thread->rpc_stack[0]--;
+		if (os_processes[process_id].rpc_cancel_signal < 32)
+		{
+			os_kill(os_processes[process_id].rpc_cancel_thread, os_processes[process_id].rpc_cancel_signal);
+		}
+	}
+
+	if (thread_id != os_get_current_thread())
+	{
+		/* Thread may be blocked anywhere inside the callee. Timeout
+		 * of abandoned wait must not fire into unrelated wait later.
+		 */
+		os_cancel_timed_event(thread_id, TIMER_SLEEP);
+		os_cancel_timed_event(thread_id, TIMER_WAIT);
+		if (thread->state == THREAD_STATE_STOPPED
+				|| thread->state == THREAD_STATE_WAITING
+				|| thread->state == THREAD_STATE_BLOCKED_JOINING)
+		{
+			thread->block_object = 0;
+			thread->state = THREAD_STATE_READY;
+		}
+	}
+
+	os_rpc_unwind(thread_id, frame, E_TIMEOUT);
+	os_sched_yield();
+}
+
+int os_rpc_cancel_notify(Thread_t thread_id, uint32_t signal)
+{
+	if (thread_id >= OS_THREADS || os_threads[thread_id].state == THREAD_STATE_EMPTY)
+	{
+		return E_INVALID;
+	}
+
+	Process_t process_id = os_get_current_process();
+	os_processes[process_id].rpc_cancel_thread = thread_id;
+	os_processes[process_id].rpc_cancel_signal = signal < 32 ? signal : 0xFF;
+
+	return E_OK;
+}
 
 /** @} */
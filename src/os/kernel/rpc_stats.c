@@ -0,0 +1,137 @@
+/** @addtogroup os_rpc_stats
+ * @{
+ */
+#include <cmrx/os/rpc_stats.h>
+#include <cmrx/os/runtime.h>
+#include <cmrx/os/arch/sched.h>
+#include <conf/kernel.h>
+
+#if defined(KERNEL_HAS_RPC_STATISTICS) || defined(KERNEL_HAS_RPC_TRACE)
+
+/** Call currently in progress at given RPC stack depth. */
+struct OS_RPC_frame_t {
+	uint32_t entered;           ///< timestamp at which method was entered
+	VTable_t * vtable;          ///< vtable of called service
+	uint16_t method;            ///< index of called method
+};
+
+/** Calls in progress, per thread and RPC stack depth. */
+static struct OS_RPC_frame_t os_rpc_frames[OS_THREADS][OS_RPC_MAX_DEPTH];
+
+#ifdef KERNEL_HAS_RPC_STATISTICS
+
+/** Per-method RPC statistics. */
+struct OS_RPC_stat_t os_rpc_stats[OS_RPC_STATS_ENTRIES];
+
+/** Amount of calls which did not fit into @ref os_rpc_stats. */
+uint32_t os_rpc_stats_dropped;
+
+/** Find statistics entry for method.
+ * Allocates new entry if method has none yet.
+ * @returns address of entry or NULL if table is full
+ */
+static struct OS_RPC_stat_t * os_rpc_stats_find(Process_t process_id, VTable_t * vtable, unsigned method)
+{
+	for (int q = 0; q < OS_RPC_STATS_ENTRIES; ++q)
+	{
+		struct OS_RPC_stat_t * stat = &os_rpc_stats[q];
+		if (stat->vtable == NULL)
+		{
+			stat->vtable = vtable;
+			stat->method = method;
+			stat->process = process_id;
+			return stat;
+		}
+
+		if (stat->vtable == vtable && stat->method == method && stat->process == process_id)
+		{
+			return stat;
+		}
+	}
+
+	return NULL;
+}
+
+#endif
+
+#ifdef KERNEL_HAS_RPC_TRACE
+
+/** RPC trace ring buffer. */
+struct OS_RPC_trace_t os_rpc_trace[OS_RPC_TRACE_SIZE];
+
+/** Total amount of events recorded. Position of next write is this value
+ * modulo @ref OS_RPC_TRACE_SIZE. */
+uint32_t os_rpc_trace_count;
+
+/** Store event into trace buffer. */
+static void os_rpc_trace_event(uint32_t timestamp, Thread_t thread_id, Process_t process_id, const struct OS_RPC_frame_t * frame, uint8_t depth, uint8_t event)
+{
+	struct OS_RPC_trace_t * entry = &os_rpc_trace[os_rpc_trace_count % OS_RPC_TRACE_SIZE];
+	entry->timestamp = timestamp;
+	entry->vtable = frame->vtable;
+	entry->method = frame->method;
+	entry->event = event;
+	entry->thread = thread_id;
+	entry->process = process_id;
+	entry->depth = depth;
+	os_rpc_trace_count++;
+}
+
+#endif
+
+void os_rpc_stats_enter(Thread_t thread_id, Process_t process_id, VTable_t * vtable, unsigned method)
+{
+	uint8_t depth = os_threads[thread_id].rpc_stack[0];
+	struct OS_RPC_frame_t * frame = &os_rpc_frames[thread_id][depth - 1];
+
+	frame->entered = os_cycle_count();
+	frame->vtable = vtable;
+	frame->method = method;
+
+#ifdef KERNEL_HAS_RPC_TRACE
+	os_rpc_trace_event(frame->entered, thread_id, process_id, frame, depth, RPC_TRACE_CALL);
+#else
+	(void) process_id;
+#endif
+}
+
+void os_rpc_stats_leave(Thread_t thread_id, bool aborted)
+{
+	uint8_t depth = os_threads[thread_id].rpc_stack[0];
+	if (depth == 0)
+	{
+		return;
+	}
+
+	Process_t process_id = os_threads[thread_id].rpc_stack[depth];
+	struct OS_RPC_frame_t * frame = &os_rpc_frames[thread_id][depth - 1];
+	uint32_t now = os_cycle_count();
+
+#ifdef KERNEL_HAS_RPC_STATISTICS
+	struct OS_RPC_stat_t * stat = os_rpc_stats_find(process_id, frame->vtable, frame->method);
+	if (stat != NULL)
+	{
+		uint32_t elapsed = now - frame->entered;
+		stat->calls++;
+		stat->time += elapsed;
+		if (elapsed > stat->time_max)
+		{
+			stat->time_max = elapsed;
+		}
+	}
+	else
+	{
+		os_rpc_stats_dropped++;
+	}
+#endif
+
+#ifdef KERNEL_HAS_RPC_TRACE
+	os_rpc_trace_event(now, thread_id, process_id, frame, depth, aborted ? RPC_TRACE_ABORT : RPC_TRACE_RETURN);
+#else
+	(void) aborted;
+#endif
+}
+
+#endif
+
+/** @} */
@@ -14,6 +14,7 @@
 #include <cmrx/os/arch/sched.h>
 #include <cmrx/os/arch/mpu.h>
 #include <cmrx/os/timer.h>
+#include <cmrx/os/mqueue.h>
 #include <cmrx/os/syscalls.h>
 #include <cmrx/clock.h>
 #include <string.h>
@@ -267,6 +268,7 @@ int os_thread_kill(uint8_t thread_id, int status)
 	{
 		os_threads[thread_id].state = THREAD_STATE_FINISHED;
 		os_threads[thread_id].exit_status = status;
+		os_mqueue_thread_exit(thread_id);
 
 		os_stack_dispose(os_threads[thread_id].stack_id);
 		os_threads[thread_id].stack_id = OS_TASK_NO_STACK;
@@ -327,6 +329,53 @@ int os_setpriority(uint8_t priority)
 	return 0;
 }
 
+int os_priority_ceiling(uint8_t ceiling)
+{
+	struct OS_thread_t * thread = &os_threads[os_get_current_thread()];
+	uint8_t priority = thread->priority;
+
+	/* Raising priority of running thread never causes it to be preempted */
+	if (ceiling < priority)
+	{
+		thread->priority = ceiling;
+	}
+
+	return priority;
+}
+
+int os_thread_map_window(Thread_t thread_id, const void * base, uint32_t size, uint8_t flags)
+{
+	if (thread_id >= OS_THREADS)
+	{
+		return E_INVALID;
+	}
+
+	struct OS_MPU_window_t * window = &os_threads[thread_id].mpu_window;
+	window->base = base;
+	window->size = size;
+	window->flags = flags;
+	window->subregions = 0xFF;
+
+	if (thread_id == os_get_current_thread())
+	{
+		int rv = mpu_load_window(os_thread_window(thread_id));
+		if (rv != E_OK)
+		{
+			/* Don't keep window which MPU can't map */
+			window->base = NULL;
+			mpu_load_window(os_thread_window(thread_id));
+		}
+		return rv;
+	}
+
+	return E_OK;
+}
+
+const struct OS_MPU_window_t * os_thread_window(Thread_t thread_id)
+{
+	return &os_threads[thread_id].mpu_window;
+}
+
 int os_thread_join(uint8_t thread_id)
 {
 	if (thread_id < OS_THREADS)
@@ -422,7 +471,6 @@ int os_thread_alloc(Process_t process, uint8_t priority)
 			os_threads[q].sp = (unsigned long *) ~0;
 			os_threads[q].state = THREAD_STATE_CREATED;
 			os_threads[q].signals = 0;
-			os_threads[q].signal_handler = NULL;
 			os_threads[q].priority = priority;
 			return q;
 		}
@@ -452,6 +500,7 @@ void os_start()
 	for (unsigned q = 0; q < applications; ++q)
 	{
 		os_process_create(q, &app_definition[q]);
+		os_processes[q].rpc_cancel_signal = 0xFF;
 	}
 
 	for (unsigned q = 0; q < threads; ++q)
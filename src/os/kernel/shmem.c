@@ -0,0 +1,193 @@
+/** @addtogroup os_shmem
+ * @{
+ */
+#include <cmrx/os/shmem.h>
+#include <cmrx/os/runtime.h>
+#include <cmrx/os/sched.h>
+#include <cmrx/os/mpu.h>
+#include <cmrx/os/arch/mpu.h>
+#include <cmrx/ipc/shmem.h>
+#include <cmrx/defines.h>
+#include <conf/kernel.h>
+#include <stdbool.h>
+
+/** Shared memory window kernel object. */
+struct OS_shmem_window_t {
+	/** Base address of window */
+	void * base;
+	/** Size of window */
+	uint32_t size;
+	/** Process owning memory of window */
+	Process_t owner;
+	/** Process memory is shared with */
+	Process_t peer;
+	/** True if window is in use */
+	bool allocated;
+};
+
+static struct OS_shmem_window_t os_shmem_windows[OS_SHMEM_WINDOWS];
+
+/** Find process by its static definition.
+ * @param definition definition of process
+ * @returns process ID or OS_PROCESSES if there is no such process
+ */
+static Process_t os_shmem_find_process(const struct OS_process_definition_t * definition)
+{
+	for (Process_t q = 0; q < OS_PROCESSES; ++q)
+	{
+		if (definition != NULL && os_processes[q].definition == definition)
+		{
+			return q;
+		}
+	}
+
+	return OS_PROCESSES;
+}
+
+/** Check if process takes part in any window.
+ * @param process_id process checked
+ * @returns true if process is owner or peer of some window
+ */
+static bool os_shmem_process_busy(Process_t process_id)
+{
+	for (int q = 0; q < OS_SHMEM_WINDOWS; ++q)
+	{
+		if (os_shmem_windows[q].allocated
+				&& (os_shmem_windows[q].owner == process_id || os_shmem_windows[q].peer == process_id))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/** Check if memory block lies within memory of process.
+ * @param process_id process checked
+ * @param base base address of block
+ * @param size size of block
+ * @returns true if process can access whole block
+ */
+static bool os_shmem_owns(Process_t process_id, const void * base, uint32_t size)
+{
+	const struct OS_process_definition_t * definition = os_processes[process_id].definition;
+	const uint8_t * start = base;
+
+	for (int q = 0; q < OS_TASK_MPU_REGIONS; ++q)
+	{
+		const uint8_t * region_start = definition->mpu_regions[q].start;
+		const uint8_t * region_end = definition->mpu_regions[q].end;
+
+		if (start >= region_start && start < region_end && size <= (uint32_t) (region_end - start))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/** Load window of process into MPU, if process is running right now.
+ * Shared window is part of memory of process currently hosting the thread,
+ * which is the callee if thread is inside RPC call.
+ * @param process_id process whose window changed
+ */
+static void os_shmem_reload(Process_t process_id)
+{
+	struct OS_thread_t * thread = os_thread_get(os_get_current_thread());
+	Process_t host = thread->rpc_stack[0] != 0 ? thread->rpc_stack[thread->rpc_stack[0]] : thread->process_id;
+
+	if (host == process_id)
+	{
+		mpu_load_shared_window(&os_processes[process_id].mpu);
+	}
+}
+
+int os_shmem_window_open(const struct OS_process_definition_t * peer, void * base, unsigned size, unsigned flags)
+{
+	Process_t owner = os_get_current_process();
+	Process_t peer_id = os_shmem_find_process(peer);
+
+	if (peer_id == OS_PROCESSES || peer_id == owner
+			|| (flags & ~(SHMEM_PEER_WRITE | SHMEM_OWNER_READ_ONLY)) != 0)
+	{
+		return -E_INVALID;
+	}
+
+	if (size < 32 || (size & (size - 1)) != 0 || ((uintptr_t) base & (size - 1)) != 0)
+	{
+		return -E_MISALIGNED;
+	}
+
+	if (!os_shmem_owns(owner, base, size))
+	{
+		return -E_INVALID_ADDRESS;
+	}
+
+	if (os_shmem_process_busy(owner) || os_shmem_process_busy(peer_id))
+	{
+		return -E_BUSY;
+	}
+
+	for (int q = 0; q < OS_SHMEM_WINDOWS; ++q)
+	{
+		struct OS_shmem_window_t * window = &os_shmem_windows[q];
+		if (window->allocated)
+		{
+			continue;
+		}
+
+		int rv = mpu_set_shared_window(&os_processes[owner].mpu, base, size,
+				(flags & SHMEM_OWNER_READ_ONLY) ? MPU_R : MPU_RW);
+		if (rv != E_OK)
+		{
+			return -rv;
+		}
+
+		rv = mpu_set_shared_window(&os_processes[peer_id].mpu, base, size,
+				(flags & SHMEM_PEER_WRITE) ? MPU_RW : MPU_R);
+		if (rv != E_OK)
+		{
+			mpu_set_shared_window(&os_processes[owner].mpu, NULL, 0, MPU_NONE);
+			return -rv;
+		}
+
+		window->base = base;
+		window->size = size;
+		window->owner = owner;
+		window->peer = peer_id;
+		window->allocated = true;
+
+		os_shmem_reload(owner);
+		os_shmem_reload(peer_id);
+		return q;
+	}
+
+	return -E_OUT_OF_RANGE;
+}
+
+int os_shmem_window_close(int window_id)
+{
+	if (window_id < 0 || window_id >= OS_SHMEM_WINDOWS || !os_shmem_windows[window_id].allocated)
+	{
+		return E_INVALID;
+	}
+
+	struct OS_shmem_window_t * window = &os_shmem_windows[window_id];
+	Process_t caller = os_get_current_process();
+
+	if (window->owner != caller && window->peer != caller)
+	{
+		return E_INVALID;
+	}
+
+	mpu_set_shared_window(&os_processes[window->owner].mpu, NULL, 0, MPU_NONE);
+	mpu_set_shared_window(&os_processes[window->peer].mpu, NULL, 0, MPU_NONE);
+	window->allocated = false;
+
+	os_shmem_reload(window->owner);
+	os_shmem_reload(window->peer);
+	return E_OK;
+}
+
+/** @} */
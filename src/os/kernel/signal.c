@@ -5,34 +5,177 @@
 #include <cmrx/assert.h>
 #include <cmrx/ipc/signal.h>
 #include <cmrx/os/sched.h>
+#include <cmrx/os/signal.h>
+#include <cmrx/os/notify.h>
+#include <cmrx/os/arch/sched.h>
 
-int os_signal(int signo, void (*sighandler)(int))
+/** Check if thread is able to receive signals.
+ * @param thread_id ID of recipient thread
+ * @returns true if thread is alive and can receive signals
+ */
+static bool os_signal_receivable(uint8_t thread_id)
+{
+	return os_threads[thread_id].state == THREAD_STATE_READY
+			|| os_threads[thread_id].state == THREAD_STATE_RUNNING
+			|| os_threads[thread_id].state == THREAD_STATE_STOPPED
+			|| os_threads[thread_id].state == THREAD_STATE_WAITING;
+}
+
+/** Take pending signals out of thread.
+ * Clears signals in mask from pending mask and removes queued signals
+ * in mask from signal queue. Values of queued signals are dropped.
+ * @param thread thread owning the signals
+ * @param mask mask of signals taken
+ * @returns mask of signals which were pending
+ */
+static uint32_t os_signal_take(struct OS_thread_t * thread, uint32_t mask)
+{
+	uint32_t taken = thread->signals & mask;
+	thread->signals &= ~mask;
+
+#ifdef KERNEL_HAS_SIGNAL_QUEUE
+	unsigned kept = 0;
+	for (unsigned q = 0; q < thread->signal_queue_count; ++q)
+	{
+		struct OS_signal_entry_t entry = thread->signal_queue[(thread->signal_queue_head + q) % OS_SIGNAL_QUEUE_DEPTH];
+		if ((mask & (1 << entry.signo)) != 0)
+		{
+			taken |= 1 << entry.signo;
+		}
+		else
+		{
+			thread->signal_queue[(thread->signal_queue_head + kept) % OS_SIGNAL_QUEUE_DEPTH] = entry;
+			kept++;
+		}
+	}
+	thread->signal_queue_count = kept;
+#endif
+
+	return taken;
+}
+
+uint32_t os_signal_pending(Thread_t thread_id)
+{
+	struct OS_thread_t * thread = &os_threads[thread_id];
+	uint32_t pending = thread->signals;
+
+#ifdef KERNEL_HAS_SIGNAL_QUEUE
+	for (unsigned q = 0; q < thread->signal_queue_count; ++q)
+	{
+		pending |= 1 << thread->signal_queue[(thread->signal_queue_head + q) % OS_SIGNAL_QUEUE_DEPTH].signo;
+	}
+#endif
+
+	return pending;
+}
+
+/** Make thread aware of newly pending signal.
+ * If thread waits for the signal in sigwait(), then it is woken up and
+ * signals it waits for are handed over to it. If thread waits for the
+ * signal in wait_objects(), then it is woken up and signal stays pending.
+ * Otherwise if thread is not
+ * executing right now and its context is saved, then signals are delivered
+ * onto its stack immediately. Otherwise they are delivered once thread gets
+ * scheduled. Stopped thread is woken up.
+ * @param thread_id ID of recipient thread
+ */
+static void os_signal_wakeup(uint8_t thread_id)
+{
+	struct OS_thread_t * thread = &os_threads[thread_id];
+
+	int entry = os_wait_entry(thread_id, &thread->signals);
+	if (entry >= 0)
+	{
+		uint32_t mask = thread->wait_list[entry].mask;
+		if (thread->block_object == (unsigned long) &thread->signals)
+		{
+			uint32_t taken = os_signal_take(thread, mask);
+			if (taken != 0)
+			{
+				os_notify_waiter(thread_id, entry, (int) taken);
+				return;
+			}
+		}
+		else if ((os_signal_pending(thread_id) & mask) != 0)
+		{
+			/* Waiter was told signal is pending, handler must not
+			 * consume it before waiter gets to run.
+			 */
+			os_notify_waiter(thread_id, entry, 0);
+			return;
+		}
+	}
+
+	/* Stack pointer of thread being switched out is stale until its
+	 * context is saved. Signals are delivered once it is switched in.
+	 */
+	if (thread_id != os_get_current_thread()
+			&& thread != os_context_live_thread()
+			&& (os_threads[thread_id].state == THREAD_STATE_READY
+				|| os_threads[thread_id].state == THREAD_STATE_STOPPED))
+	{
+		os_deliver_pending_signals(&os_threads[thread_id]);
+	}
+
+	if (os_threads[thread_id].state == THREAD_STATE_STOPPED)
+	{
+		os_thread_continue(thread_id);
+	}
+}
+
+void os_deliver_pending_signals(struct OS_thread_t * thread)
+{
+#ifdef KERNEL_HAS_SIGNAL_QUEUE
+	/* Frames nest, the one delivered last runs first. Deliver from
+	 * the newest entry so that handlers see signals in order they were queued.
+	 */
+	while (thread->signal_queue_count > 0)
+	{
+		unsigned slot = (thread->signal_queue_head + thread->signal_queue_count - 1) % OS_SIGNAL_QUEUE_DEPTH;
+		struct OS_signal_entry_t * entry = &thread->signal_queue[slot];
+		if (thread->signal_handlers[entry->signo] == NULL)
+		{
+			/* Nobody handles this signal, keep it pending without value */
+			thread->signals |= 1 << entry->signo;
+		}
+		else if (os_deliver_signal(thread, 1 << entry->signo, entry->value) == 0)
+		{
+			return;
+		}
+		thread->signal_queue_count--;
+	}
+	thread->signal_queue_head = 0;
+#endif
+
+	if (thread->signals != 0)
+	{
+		thread->signals &= ~os_deliver_signal(thread, thread->signals, 0);
+	}
+}
+
+int os_signal(int signo, void (*sighandler)(uint32_t, uint32_t))
 {
-    (void) signo;
-    /* @todo: what to do with signo? */
 	uint8_t thread_id = os_get_current_thread();
 	ASSERT(thread_id < OS_THREADS);
 
-	os_threads[thread_id].signal_handler = sighandler;
+	if (signo < 0 || signo >= 32)
+	{
+		return E_INVALID;
+	}
+
+	os_threads[thread_id].signal_handlers[signo] = sighandler;
 	return 0;
 }
 
 int os_kill(uint8_t thread_id, uint8_t signal_id)
 {
 	ASSERT(thread_id < OS_THREADS);
-	if (os_threads[thread_id].state == THREAD_STATE_READY 
-			|| os_threads[thread_id].state == THREAD_STATE_RUNNING
-			|| os_threads[thread_id].state == THREAD_STATE_STOPPED
-			)
+	if (os_signal_receivable(thread_id))
 	{
 		if (signal_id < 32)
 		{
 			os_threads[thread_id].signals |= 1 << signal_id;
-
-			if (os_threads[thread_id].state == THREAD_STATE_STOPPED)
-			{
-				os_thread_continue(thread_id);
-			}
+			os_signal_wakeup(thread_id);
 			return 0;
 		}
 		else
@@ -64,4 +207,59 @@ int os_kill(uint8_t thread_id, uint8_t signal_id)
 	return E_INVALID;
 }
 
+int os_sigqueue(uint8_t thread_id, uint8_t signal_id, uint32_t value)
+{
+	ASSERT(thread_id < OS_THREADS);
+	if (signal_id >= 32)
+	{
+		/* Non-catchable signals carry no value */
+		return os_kill(thread_id, signal_id);
+	}
+
+	if (!os_signal_receivable(thread_id))
+	{
+		return E_INVALID;
+	}
+
+#ifdef KERNEL_HAS_SIGNAL_QUEUE
+	struct OS_thread_t * thread = &os_threads[thread_id];
+	if (thread->signal_queue_count >= OS_SIGNAL_QUEUE_DEPTH)
+	{
+		return E_BUSY;
+	}
+
+	unsigned slot = (thread->signal_queue_head + thread->signal_queue_count) % OS_SIGNAL_QUEUE_DEPTH;
+	thread->signal_queue[slot].signo = signal_id;
+	thread->signal_queue[slot].value = value;
+	thread->signal_queue_count++;
+#else
+	(void) value;
+	os_threads[thread_id].signals |= 1 << signal_id;
+#endif
+
+	os_signal_wakeup(thread_id);
+	return 0;
+}
+
+int os_sigwait(uint32_t mask, unsigned microseconds)
+{
+	Thread_t thread_id = os_get_current_thread();
+	struct OS_thread_t * thread = &os_threads[thread_id];
+
+	uint32_t taken = os_signal_take(thread, mask);
+	if (taken != 0 || mask == 0 || microseconds == 0)
+	{
+		return (int) taken;
+	}
+
+	thread->wait_list[0].object = (unsigned long) &thread->signals;
+	thread->wait_list[0].mask = mask;
+	os_wait_for_object_timeout(&thread->signals, microseconds);
+
+	/* This is returned if wait times out. If signal arrives,
+	 * then os_signal_wakeup() replaces it by signals taken.
+	 */
+	return 0;
+}
+
 /** @} */
@@ -11,6 +11,14 @@
 #include <cmrx/os/sched.h>
 #include <cmrx/os/timer.h>
 #include <cmrx/os/signal.h>
+#include <cmrx/os/futex.h>
+#include <cmrx/os/event.h>
+#include <cmrx/os/wait.h>
+#include <cmrx/os/notify.h>
+#include <cmrx/os/lock_profile.h>
+#include <cmrx/os/mqueue.h>
+#include <cmrx/os/buffer.h>
+#include <cmrx/os/shmem.h>
 
 /** @defgroup os_syscall System calls
  * @ingroup os
@@ -38,14 +46,51 @@ static const struct Syscall_Entry_t syscalls[] = {
 	{ SYSCALL_SETITIMER, (Syscall_Handler_t) &os_setitimer },
 	{ SYSCALL_SIGNAL, (Syscall_Handler_t) &os_signal },
 	{ SYSCALL_KILL, (Syscall_Handler_t) &os_kill },
-	{ SYSCALL_SETPRIORITY, (Syscall_Handler_t) &os_setpriority }
+	{ SYSCALL_SETPRIORITY, (Syscall_Handler_t) &os_setpriority },
+	{ SYSCALL_RPC_CALL_ASYNC, (Syscall_Handler_t) &os_rpc_call_async },
+	{ SYSCALL_RPC_SERVE, (Syscall_Handler_t) &os_rpc_serve },
+	{ SYSCALL_RPC_ASYNC_RETURN, (Syscall_Handler_t) &os_rpc_async_return },
+	{ SYSCALL_RPC_POLL, (Syscall_Handler_t) &os_rpc_poll },
+	{ SYSCALL_RPC_RESULT, (Syscall_Handler_t) &os_rpc_result },
+	{ SYSCALL_RPC_CALL_QUEUED, (Syscall_Handler_t) &os_rpc_call_queued },
+	{ SYSCALL_RPC_CALL_TIMED, (Syscall_Handler_t) &os_rpc_call_timed },
+	{ SYSCALL_RPC_CANCEL_NOTIFY, (Syscall_Handler_t) &os_rpc_cancel_notify },
+	{ SYSCALL_SIGQUEUE, (Syscall_Handler_t) &os_sigqueue },
+	{ SYSCALL_SIGWAIT, (Syscall_Handler_t) &os_sigwait },
+	{ SYSCALL_FUTEX_WAIT, (Syscall_Handler_t) &os_futex_wait },
+	{ SYSCALL_FUTEX_WAKE, (Syscall_Handler_t) &os_futex_wake },
+	{ SYSCALL_EVENT_GROUP_CREATE, (Syscall_Handler_t) &os_event_group_create },
+	{ SYSCALL_EVENT_GROUP_DELETE, (Syscall_Handler_t) &os_event_group_delete },
+	{ SYSCALL_EVENT_GROUP_SET, (Syscall_Handler_t) &os_event_group_set },
+	{ SYSCALL_EVENT_GROUP_CLEAR, (Syscall_Handler_t) &os_event_group_clear },
+	{ SYSCALL_EVENT_GROUP_WAIT, (Syscall_Handler_t) &os_event_group_wait },
+	{ SYSCALL_WAIT_OBJECTS, (Syscall_Handler_t) &os_wait_objects },
+	{ SYSCALL_NOTIFY_GIVE, (Syscall_Handler_t) &os_notify_give },
+	{ SYSCALL_NOTIFY_TAKE, (Syscall_Handler_t) &os_notify_take },
+	{ SYSCALL_PRIORITY_CEILING, (Syscall_Handler_t) &os_priority_ceiling },
+	{ SYSCALL_FUTEX_REQUEUE, (Syscall_Handler_t) &os_futex_requeue },
+	{ SYSCALL_MQUEUE_CREATE, (Syscall_Handler_t) &os_mqueue_create },
+	{ SYSCALL_MQUEUE_DELETE, (Syscall_Handler_t) &os_mqueue_delete },
+	{ SYSCALL_MQUEUE_SEND, (Syscall_Handler_t) &os_mqueue_send },
+	{ SYSCALL_MQUEUE_RECEIVE, (Syscall_Handler_t) &os_mqueue_receive },
+	{ SYSCALL_MQUEUE_RECEIVE_MAP, (Syscall_Handler_t) &os_mqueue_receive_map },
+	{ SYSCALL_MQUEUE_RELEASE, (Syscall_Handler_t) &os_mqueue_release },
+	{ SYSCALL_BUFFER_ALLOC, (Syscall_Handler_t) &os_buffer_alloc },
+	{ SYSCALL_BUFFER_ADDRESS, (Syscall_Handler_t) &os_buffer_address },
+	{ SYSCALL_BUFFER_SEND, (Syscall_Handler_t) &os_buffer_send },
+	{ SYSCALL_BUFFER_FREE, (Syscall_Handler_t) &os_buffer_free },
+	{ SYSCALL_SHMEM_WINDOW_OPEN, (Syscall_Handler_t) &os_shmem_window_open },
+	{ SYSCALL_SHMEM_WINDOW_CLOSE, (Syscall_Handler_t) &os_shmem_window_close },
+#ifdef KERNEL_HAS_LOCK_PROFILE
+	{ SYSCALL_LOCK_PROFILE, (Syscall_Handler_t) &os_lock_profile_event },
+#endif
 };
 
 #pragma GCC diagnostic pop
 
 int os_system_call(uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3, uint8_t syscall_id)
 {
-	ASSERT(syscall_id < (sizeof(syscalls) / sizeof(syscalls[0])));
+	ASSERT(syscall_id < _SYSCALL_COUNT);
 	for (unsigned q = 0; q < (sizeof(syscalls) / sizeof(syscalls[0])); ++q)
 	{
 		if (syscalls[q].id == syscall_id)
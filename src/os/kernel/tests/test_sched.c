@@ -57,6 +57,15 @@ int mpu_set_region(uint8_t region, const void * base, uint32_t size, uint8_t fla
 	return 0;
 }
 
+int mpu_load_window(const struct OS_MPU_window_t * window)
+{
+	return 0;
+}
+
+void os_mqueue_thread_exit(Thread_t thread_id)
+{
+}
+
 bool systick_enable_called = false;
 
 void systick_enable()
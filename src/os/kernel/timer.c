@@ -4,6 +4,8 @@
 #include <cmrx/os/timer.h>
 #include <cmrx/os/sched.h>
 #include <cmrx/os/signal.h>
+#include <cmrx/os/rpc.h>
+#include <cmrx/os/notify.h>
 #include <conf/kernel.h>
 
 #include <stdint.h>
@@ -21,114 +23,81 @@ struct TimerEntry_t {
 	uint32_t sleep_from;      ///< time at which sleep has been requested
 	uint32_t interval;        ///< amount of time sleep shall take
 	uint8_t thread_id;        ///< thread ID which requested the sleep
+	uint8_t kind;             ///< kind of timed event, see @ref TimerEntryKind
 };
 
 /** List of all delays requested from kernel.
  * This structure contains all scheduled sleeps requested by all threads.
- * Every thread can technically request one periodic timer and one one-shot
- * delay.
+ * Every thread can technically own one timed event of each kind.
  */
 struct TimerEntry_t sleepers[SLEEPERS_MAX];
 
-/** Determine if interval in sleep entry is periodic or not.
- * @returns 1 if interval is periodic, 0 if interval is one-shot.
- */
-#define IS_PERIODIC(interval) (((interval) >> 31) == 1)
-
-/** Get how long the sleep should take.
- * Will clean the periodicity flag from interval.
- * @returns sleep time in microseconds.
- */
-#define GET_SLEEPTIME(interval) ((interval) & (~(1 << 31)))
-
 /** Perform heavy lifting of setting timers
  * This routine will store timed event into list of timed events. If 
- * event is not periodic, it will also stop thread (\ref os_usleep semantics).
+ * event is a sleep, it will also stop thread (\ref os_usleep semantics).
  *
  * @param slot number of slot in \ref sleepers list
+ * @param owner thread which owns the timed event
  * @param interval amount of us for which thread should sleep
- * @param _periodic true if timer should be periodic, false otherwise
+ * @param kind kind of timed event
  * @return 0 if timer was set up properly
  */
-static int do_set_timed_event(unsigned slot, unsigned interval, bool _periodic)
+static int do_set_timed_event(unsigned slot, Thread_t owner, unsigned interval, enum TimerEntryKind kind)
 {
-	uint32_t periodic = (_periodic ? 1 : 0);
-	Thread_t thread_id = os_get_current_thread();
 	uint32_t microtime = os_get_micro_time();
-	sleepers[slot].thread_id = thread_id;
+	sleepers[slot].thread_id = owner;
 	ASSERT(sleepers[slot].thread_id < OS_THREADS);
 	sleepers[slot].sleep_from = microtime;
-	sleepers[slot].interval = interval | (periodic << 31);
-	if (!_periodic)
+	sleepers[slot].interval = interval;
+	sleepers[slot].kind = kind;
+	if (kind == TIMER_SLEEP)
 	{
-		os_thread_stop(thread_id);
+		os_thread_stop(owner);
 	}
 	return 0;
 }
 
-/** Find a slot for timed event and store it.
- *
- * This is actual execution core for both \ref os_usleep and \ref os_setitimer 
- * functions. It will find free slot or slot already occupied by calling thread
- * and will set / update timeout values.
- * @param microseconds time for which thread should sleep / wait for event
- * @param periodic true if this event is periodic
- * @returns error status. 0 means no error.
- */
-static int set_timed_event(unsigned microseconds, bool periodic)
+int os_set_timed_event(Thread_t owner, unsigned microseconds, enum TimerEntryKind kind)
 {
-	Thread_t thread_id = os_get_current_thread();
+	int free_slot = -1;
 
 	for (int q = 0; q < SLEEPERS_MAX; ++q)
 	{
 		if (sleepers[q].thread_id == 0xFF)
 		{
-			return do_set_timed_event(q, microseconds, periodic);
+			if (free_slot < 0)
+			{
+				free_slot = q;
+			}
 		}
 		else
 		{
-			if (sleepers[q].thread_id == thread_id)
+			if (sleepers[q].thread_id == owner && sleepers[q].kind == kind)
 			{
-				/* We are searching for interval timer / delay for this thread
-				 * we found some entry belonging to this thread, but it is of
-				 * different kind than we are searching for. It is delay and
-				 * we are searching for interval timer or vice versa.
+				/* This thread already owns event of the same kind,
+				 * update it.
 				 */
-				if (
-						(periodic  && IS_PERIODIC(sleepers[q].interval))
-						|| (!periodic && !(IS_PERIODIC(sleepers[q].interval)))
-				   )
-				{
-					return do_set_timed_event(q, microseconds, periodic);
-				}
+				return do_set_timed_event(q, owner, microseconds, kind);
 			}
 		}
 	}
+
+	if (free_slot >= 0)
+	{
+		return do_set_timed_event(free_slot, owner, microseconds, kind);
+	}
+
 	return E_NOTAVAIL;
 }
 
-/** Cancels existing timed event.
- *
- * This function is only accessible for periodic timers externally. It
- * allows cancelling of interval timers set previously.
- * @param owner thread which shall own the interval timer
- * @param periodic true if periodic timer of given thread should be cancelled
- * @return 0 if operation performed succesfully.
- */
-static int cancel_timed_event(Thread_t owner, bool periodic)
+int os_cancel_timed_event(Thread_t owner, enum TimerEntryKind kind)
 {
 	for (int q = 0; q < SLEEPERS_MAX; ++q)
 	{
-		if (sleepers[q].thread_id == owner)
+		if (sleepers[q].thread_id == owner && sleepers[q].kind == kind)
 		{
-			if (
-					(periodic && !IS_PERIODIC(sleepers[q].interval))
-					|| (!periodic && IS_PERIODIC(sleepers[q].interval))
-			   )
-			{
-				sleepers[q].thread_id = 0xFF;
-				return 0;
-			}
+			sleepers[q].thread_id = 0xFF;
+			return 0;
 		}
 	}
 
@@ -152,18 +121,18 @@ int os_usleep(unsigned microseconds)
 		delay_us(microseconds);
 		return 0;
 	}
-	return set_timed_event(microseconds, false);
+	return os_set_timed_event(os_get_current_thread(), microseconds, TIMER_SLEEP);
 }
 
 int os_setitimer(unsigned microseconds)
 {
 	if (microseconds > 0)
 	{
-		return set_timed_event(microseconds, true);
+		return os_set_timed_event(os_get_current_thread(), microseconds, TIMER_PERIODIC);
 	}
 	else
 	{
-		return cancel_timed_event(os_get_current_thread(), true);
+		return os_cancel_timed_event(os_get_current_thread(), TIMER_PERIODIC);
 	}
 }
 
@@ -208,7 +177,7 @@ bool os_schedule_timer(unsigned * delay)
 			/* Figure out how long should this particular sleeper continue
 			 * to sleep
 			 */
-			uint32_t tosleep = GET_SLEEPTIME(sleepers[q].interval);
+			uint32_t tosleep = sleepers[q].interval;
 
 			uint32_t delay;
 			if (sleeping < tosleep)
@@ -244,17 +213,31 @@ void os_run_timer(uint32_t microtime)
 		if (sleepers[q].thread_id != 0xFF)
 		{
 
-			if (get_sleep_time(sleepers[q].sleep_from, microtime) >= GET_SLEEPTIME(sleepers[q].interval))
+			if (get_sleep_time(sleepers[q].sleep_from, microtime) >= sleepers[q].interval)
 			{
-				// restart usleep-ed thread
-				os_thread_continue(sleepers[q].thread_id);
-				if (IS_PERIODIC(sleepers[q].interval))
-				{
-					sleepers[q].sleep_from = sleepers[q].sleep_from + GET_SLEEPTIME(sleepers[q].interval);
-				}
-				else
+				Thread_t thread_id = sleepers[q].thread_id;
+				switch (sleepers[q].kind)
 				{
-					sleepers[q].thread_id = 0xFF;
+					case TIMER_PERIODIC:
+						os_thread_continue(thread_id);
+						sleepers[q].sleep_from = sleepers[q].sleep_from + sleepers[q].interval;
+						break;
+
+					case TIMER_DEADLINE:
+						sleepers[q].thread_id = 0xFF;
+						os_rpc_deadline_expired(thread_id);
+						break;
+
+					case TIMER_WAIT:
+						sleepers[q].thread_id = 0xFF;
+						os_wait_timeout_expired(thread_id);
+						break;
+
+					default:
+						// restart usleep-ed thread
+						sleepers[q].thread_id = 0xFF;
+						os_thread_continue(thread_id);
+						break;
 				}
 			}
 		}
@@ -0,0 +1,138 @@
+/** @addtogroup os_wait
+ * @{
+ */
+#include <cmrx/os/wait.h>
+#include <cmrx/os/event.h>
+#include <cmrx/os/notify.h>
+#include <cmrx/os/runtime.h>
+#include <cmrx/os/sched.h>
+#include <cmrx/os/signal.h>
+#include <cmrx/os/arch/mpu.h>
+#include <cmrx/defines.h>
+#include <conf/kernel.h>
+
+/** Translate source description into wait list entry.
+ * @param thread_id thread which is going to wait
+ * @param object source description
+ * @param entry wait list entry to be filled
+ * @returns E_OK if source is valid, error code otherwise
+ */
+static int os_wait_prepare(Thread_t thread_id, const struct WaitObject * object, struct OS_wait_entry_t * entry)
+{
+	entry->mask = object->value;
+	entry->flags = object->flags;
+
+	switch (object->type)
+	{
+		case WAIT_FUTEX:
+			if ((object->object % sizeof(uint32_t)) != 0)
+			{
+				return E_MISALIGNED;
+			}
+			if (!mpu_user_accessible((const void *) object->object, sizeof(uint32_t), false))
+			{
+				return E_INVALID_ADDRESS;
+			}
+			entry->object = object->object;
+			return E_OK;
+
+		case WAIT_SIGNAL:
+			entry->object = (unsigned long) &os_threads[thread_id].signals;
+			return E_OK;
+
+		case WAIT_EVENT_GROUP:
+			entry->object = (unsigned long) os_event_group_object(object->object);
+			return entry->object != 0 ? E_OK : E_INVALID;
+
+		case WAIT_NOTIFICATION:
+			if (object->object >= OS_THREAD_NOTIFICATIONS)
+			{
+				return E_INVALID;
+			}
+			entry->object = (unsigned long) &os_threads[thread_id].notifications[object->object];
+			return E_OK;
+
+		default:
+			return E_INVALID;
+	}
+}
+
+/** Check if source is ready already.
+ * @param thread_id thread which is going to wait
+ * @param object source description
+ * @returns true if thread doesn't have to wait for the source
+ */
+static bool os_wait_ready(Thread_t thread_id, const struct WaitObject * object)
+{
+	switch (object->type)
+	{
+		case WAIT_FUTEX:
+			return *((uint32_t *) object->object) != object->value;
+
+		case WAIT_SIGNAL:
+			return (os_signal_pending(thread_id) & object->value) != 0;
+
+		case WAIT_EVENT_GROUP:
+			return os_event_group_poll(object->object, object->value, object->flags) != 0;
+
+		case WAIT_NOTIFICATION:
+			return os_threads[thread_id].notifications[object->object] != 0;
+
+		default:
+			return false;
+	}
+}
+
+int os_wait_objects(const struct WaitObject * objects, unsigned count, unsigned microseconds)
+{
+	Thread_t thread_id = os_get_current_thread();
+	struct OS_wait_entry_t * wait_list = os_threads[thread_id].wait_list;
+
+	if (objects == NULL || count == 0 || count > OS_WAIT_OBJECTS)
+	{
+		return -E_INVALID;
+	}
+
+	if (!mpu_user_accessible(objects, count * sizeof(struct WaitObject), false))
+	{
+		return -E_INVALID_ADDRESS;
+	}
+
+	/* Validate everything first so that no event group flags
+	 * get consumed by call which fails anyway.
+	 */
+	for (unsigned q = 0; q < count; ++q)
+	{
+		int rv = os_wait_prepare(thread_id, &objects[q], &wait_list[q]);
+		if (rv != E_OK)
+		{
+			return -rv;
+		}
+	}
+
+	for (unsigned q = 0; q < count; ++q)
+	{
+		if (os_wait_ready(thread_id, &objects[q]))
+		{
+			return q;
+		}
+	}
+
+	if (microseconds == 0)
+	{
+		return -E_TIMEOUT;
+	}
+
+	int rv = os_wait_for_objects_timeout(count, microseconds);
+	if (rv != E_OK)
+	{
+		return -rv;
+	}
+
+	/* This is returned if wait times out. If any object is notified,
+	 * then notifier replaces it by index of the object.
+	 */
+	return -E_TIMEOUT;
+}
+
+/** @} */
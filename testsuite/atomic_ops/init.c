@@ -0,0 +1,55 @@
+#include <cmrx/ipc/thread.h>
+#include <cmrx/ipc/mutex.h>
+#include <cmrx/atomic.h>
+#include <cmrx/application.h>
+#include <debug.h>
+
+#define ITERATIONS      10000
+
+static volatile uint32_t counter = 0;
+static volatile uint32_t locked_counter = 0;
+static futex_t lock = FUTEX_STATIC_INIT;
+
+int adder_main(void *)
+{
+    for (int q = 0; q < ITERATIONS; ++q)
+    {
+        atomic_add(&counter, 1);
+
+        futex_lock(&lock);
+        locked_counter++;
+        futex_unlock(&lock);
+    }
+    return 0;
+}
+
+int init_main(void *)
+{
+    uint32_t word = 5;
+    if (atomic_cas(&word, 4, 7) || word != 5 || !atomic_cas(&word, 5, 7) || word != 7)
+    {
+        TEST_FAIL();
+    }
+
+    if (atomic_add(&word, 3) != 7 || word != 10)
+    {
+        TEST_FAIL();
+    }
+
+    int first = thread_create(adder_main, NULL, 32);
+    int second = thread_create(adder_main, NULL, 32);
+    thread_join(first);
+    thread_join(second);
+
+    if (counter != 2 * ITERATIONS || locked_counter != 2 * ITERATIONS)
+    {
+        TEST_FAIL();
+    }
+
+    TEST_SUCCESS();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(atomic_ops_init, 0x40000000, 0x60000000);
+OS_APPLICATION(atomic_ops_init);
+OS_THREAD_CREATE(atomic_ops_init, init_main, NULL, 64);
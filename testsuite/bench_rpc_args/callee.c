@@ -0,0 +1,24 @@
+#include <cmrx/application.h>
+#include <cmrx/rpc/interface.h>
+#include "service.h"
+
+#include <cmrx/rpc/implementation.h>
+
+IMPLEMENTATION_OF(struct Service, struct ServiceVTable);
+
+uint32_t service_method(INSTANCE(this), uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3)
+{
+    (void) this;
+    return arg0 + arg1 + arg2 + arg3;
+}
+
+VTABLE struct ServiceVTable service_vtable = {
+    service_method
+};
+
+struct Service service = {
+    &service_vtable
+};
+
+OS_APPLICATION_MMIO_RANGE(bench_rpc_args_callee, 0x40000000, 0x60000000);
+OS_APPLICATION(bench_rpc_args_callee);
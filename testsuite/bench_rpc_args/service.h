@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cmrx/rpc/interface.h>
+#include <stdint.h>
+
+struct ServiceVTable {
+    uint32_t (*method)(INSTANCE(this), uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3);
+};
+
+struct Service {
+    const struct ServiceVTable * vtable;
+};
+
+extern struct Service service;
@@ -0,0 +1,24 @@
+#include <cmrx/application.h>
+#include <cmrx/rpc/interface.h>
+#include "service.h"
+
+#include <cmrx/rpc/implementation.h>
+
+IMPLEMENTATION_OF(struct Service, struct ServiceVTable);
+
+uint32_t service_method(INSTANCE(this))
+{
+    (void) this;
+    return 0;
+}
+
+VTABLE struct ServiceVTable service_vtable = {
+    service_method
+};
+
+struct Service service = {
+    &service_vtable
+};
+
+OS_APPLICATION_MMIO_RANGE(bench_rpc_empty_callee, 0x40000000, 0x60000000);
+OS_APPLICATION(bench_rpc_empty_callee);
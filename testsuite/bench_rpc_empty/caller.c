@@ -0,0 +1,25 @@
+#include <cmrx/application.h>
+#include <cmrx/ipc/rpc.h>
+#include <debug.h>
+#include "service.h"
+
+#define ITERATIONS      100
+
+int caller_high_prio(void * data)
+{
+    (void) data;
+
+    BENCH_START();
+    for (int q = 0; q < ITERATIONS; ++q)
+    {
+        rpc_call(&service, method);
+    }
+    BENCH_STOP("rpc_empty", ITERATIONS);
+
+	TEST_SUCCESS();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(bench_rpc_empty_caller, 0x40000000, 0x60000000);
+OS_APPLICATION(bench_rpc_empty_caller);
+OS_THREAD_CREATE(bench_rpc_empty_caller, caller_high_prio, NULL, 2);
@@ -0,0 +1,30 @@
+#include <cmrx/application.h>
+#include <cmrx/ipc/rpc.h>
+#include <cmrx/rpc/interface.h>
+#include "service.h"
+
+#include <cmrx/rpc/implementation.h>
+
+IMPLEMENTATION_OF(struct Service, struct ServiceVTable);
+
+uint32_t service_nested(INSTANCE(this), uint32_t depth)
+{
+    (void) this;
+    if (depth > 1)
+    {
+        // Each nested call pushes one more entry onto RPC stack
+        rpc_call(&service, nested, depth - 1);
+    }
+    return 0;
+}
+
+VTABLE struct ServiceVTable service_vtable = {
+    service_nested
+};
+
+struct Service service = {
+    &service_vtable
+};
+
+OS_APPLICATION_MMIO_RANGE(bench_rpc_nested_callee, 0x40000000, 0x60000000);
+OS_APPLICATION(bench_rpc_nested_callee);
@@ -0,0 +1,34 @@
+#include <cmrx/application.h>
+#include <cmrx/ipc/rpc.h>
+#include <debug.h>
+#include "service.h"
+
+#define ITERATIONS      100
+#define MAX_DEPTH       8
+
+static const char * const names[MAX_DEPTH] = {
+    "rpc_nested_1", "rpc_nested_2", "rpc_nested_3", "rpc_nested_4",
+    "rpc_nested_5", "rpc_nested_6", "rpc_nested_7", "rpc_nested_8"
+};
+
+int caller_high_prio(void * data)
+{
+    (void) data;
+
+    for (unsigned depth = 1; depth <= MAX_DEPTH; ++depth)
+    {
+        BENCH_START();
+        for (int q = 0; q < ITERATIONS; ++q)
+        {
+            rpc_call(&service, nested, depth);
+        }
+        BENCH_STOP(names[depth - 1], ITERATIONS);
+    }
+
+	TEST_SUCCESS();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(bench_rpc_nested_caller, 0x40000000, 0x60000000);
+OS_APPLICATION(bench_rpc_nested_caller);
+OS_THREAD_CREATE(bench_rpc_nested_caller, caller_high_prio, NULL, 2);
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cmrx/rpc/interface.h>
+#include <stdint.h>
+
+struct ServiceVTable {
+    uint32_t (*nested)(INSTANCE(this), uint32_t depth);
+};
+
+struct Service {
+    const struct ServiceVTable * vtable;
+};
+
+extern struct Service service;
@@ -0,0 +1,29 @@
+#include <cmrx/application.h>
+#include <cmrx/rpc/interface.h>
+#include "service.h"
+
+#include <cmrx/rpc/implementation.h>
+
+IMPLEMENTATION_OF(struct Service, struct ServiceVTable);
+
+uint32_t service_checksum(INSTANCE(this), const uint8_t * buffer, uint32_t length)
+{
+    (void) this;
+    uint32_t sum = 0;
+    for (uint32_t q = 0; q < length; ++q)
+    {
+        sum += buffer[q];
+    }
+    return sum;
+}
+
+VTABLE struct ServiceVTable service_vtable = {
+    service_checksum
+};
+
+struct Service service = {
+    &service_vtable
+};
+
+OS_APPLICATION_MMIO_RANGE(bench_rpc_shared_memory_callee, 0x40000000, 0x60000000);
+OS_APPLICATION(bench_rpc_shared_memory_callee);
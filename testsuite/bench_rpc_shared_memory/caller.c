@@ -0,0 +1,43 @@
+#include <cmrx/application.h>
+#include <cmrx/ipc/rpc.h>
+#include <cmrx/ipc/shmem.h>
+#include <debug.h>
+#include "service.h"
+
+#define ITERATIONS      20
+#define BUFFER_SIZE     1024
+
+uint8_t SHARED buffer[BUFFER_SIZE];
+
+static const unsigned sizes[] = { 16, 64, 256, 1024 };
+static const char * const names[] = {
+    "rpc_shared_memory_16", "rpc_shared_memory_64",
+    "rpc_shared_memory_256", "rpc_shared_memory_1024"
+};
+
+int caller_high_prio(void * data)
+{
+    (void) data;
+
+    for (unsigned q = 0; q < BUFFER_SIZE; ++q)
+    {
+        buffer[q] = 1;
+    }
+
+    for (unsigned s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+    {
+        BENCH_START();
+        for (int q = 0; q < ITERATIONS; ++q)
+        {
+            rpc_call(&service, checksum, buffer, sizes[s]);
+        }
+        BENCH_STOP(names[s], ITERATIONS);
+    }
+
+	TEST_SUCCESS();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(bench_rpc_shared_memory_caller, 0x40000000, 0x60000000);
+OS_APPLICATION(bench_rpc_shared_memory_caller);
+OS_THREAD_CREATE(bench_rpc_shared_memory_caller, caller_high_prio, NULL, 2);
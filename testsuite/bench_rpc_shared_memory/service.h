@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cmrx/rpc/interface.h>
+#include <stdint.h>
+
+struct ServiceVTable {
+    uint32_t (*checksum)(INSTANCE(this), const uint8_t * buffer, uint32_t length);
+};
+
+struct Service {
+    const struct ServiceVTable * vtable;
+};
+
+extern struct Service service;
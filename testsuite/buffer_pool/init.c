@@ -0,0 +1,59 @@
+#include <cmrx/ipc/thread.h>
+#include <cmrx/ipc/buffer.h>
+#include <cmrx/application.h>
+#include <conf/kernel.h>
+#include <debug.h>
+
+int init_main(void *)
+{
+    int buffers[OS_BUFFERS];
+
+    /* Allocated buffer is accessible at once */
+    for (int q = 0; q < OS_BUFFERS; ++q)
+    {
+        buffers[q] = buffer_alloc();
+        uint32_t * data = buffer_address(buffers[q]);
+        if (buffers[q] < 0 || data == NULL)
+        {
+            TEST_FAIL();
+        }
+        *data = q;
+    }
+
+    if (buffer_alloc() != -E_OUT_OF_RANGE)
+    {
+        TEST_FAIL();
+    }
+
+    /* Buffer handed over within the same process stays accessible */
+    if (buffer_send(buffers[0], get_tid()) != E_OK || *(uint32_t *) buffer_address(buffers[0]) != 0)
+    {
+        TEST_FAIL();
+    }
+
+    if (buffer_send(buffers[0], OS_THREADS) != E_INVALID || buffer_send(-1, get_tid()) != E_INVALID)
+    {
+        TEST_FAIL();
+    }
+
+    for (int q = 0; q < OS_BUFFERS; ++q)
+    {
+        if (*(uint32_t *) buffer_address(buffers[q]) != (uint32_t) q || buffer_free(buffers[q]) != E_OK)
+        {
+            TEST_FAIL();
+        }
+    }
+
+    /* Freed buffer is not accessible anymore */
+    if (buffer_address(buffers[0]) != NULL || buffer_free(buffers[0]) != E_INVALID)
+    {
+        TEST_FAIL();
+    }
+
+    TEST_SUCCESS();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(buffer_pool_init, 0x40000000, 0x60000000);
+OS_APPLICATION(buffer_pool_init);
+OS_THREAD_CREATE(buffer_pool_init, init_main, NULL, 64);
@@ -0,0 +1,12 @@
+#include <cmrx/application.h>
+#include "topics.h"
+
+COM_BUS_SUBSCRIPTION_QUEUED(queued_counter, sizeof(uint32_t), 4);
+COM_BUS_SUBSCRIPTION_LATEST(latest_counter, sizeof(uint32_t));
+
+COM_BUS_TOPIC(counter, "counter", sizeof(uint32_t), &queued_counter, &latest_counter);
+
+COM_BUS(test_bus, &counter);
+
+OS_APPLICATION_MMIO_RANGE(com_bus_bus, 0x40000000, 0x60000000);
+OS_APPLICATION(com_bus_bus);
@@ -0,0 +1,83 @@
+#include <cmrx/application.h>
+#include <cmrx/ipc/thread.h>
+#include <cmrx/ipc/timer.h>
+#include <cmrx/ipc/rpc.h>
+#include <cmrx/ipc/shmem.h>
+#include <debug.h>
+#include "topics.h"
+
+/* rpc_call() can't be used as expression, timed call returns value of method */
+#define TIMEOUT     100000
+
+static uint32_t SHARED samples[8];
+static volatile uint32_t notifications = 0;
+
+COM_NOTIFICATION(listener, id)
+{
+    (void) this;
+    if (id == 1)
+    {
+        notifications++;
+    }
+    return 0;
+}
+
+int client_main(void *)
+{
+    rpc_call(&queued_counter, set_notify, &listener, 1);
+
+    /* Two batches published before consumer reads notify it once */
+    samples[0] = 1;
+    samples[1] = 2;
+    samples[2] = 3;
+    samples[3] = 4;
+    if (rpc_call_timed(TIMEOUT, &counter, write, (const uint8_t *) samples, 3 * sizeof(uint32_t)) != E_OK
+            || rpc_call_timed(TIMEOUT, &test_bus, publish, "counter", (const uint8_t *) &samples[3], sizeof(uint32_t)) != E_OK)
+    {
+        TEST_FAIL();
+    }
+
+    if (rpc_call_timed(TIMEOUT, &test_bus, publish, "missing", (const uint8_t *) samples, sizeof(uint32_t)) != E_NOTAVAIL
+            || rpc_call_timed(TIMEOUT, &counter, write, (const uint8_t *) samples, 3) != E_WRONG_SIZE)
+    {
+        TEST_FAIL();
+    }
+
+    usleep(10000);
+    if (notifications != 1 || !rpc_call_timed(TIMEOUT, &queued_counter, ready))
+    {
+        TEST_FAIL();
+    }
+
+    /* Queued subscription holds every sample, latest one holds the last */
+    if (rpc_call_timed(TIMEOUT, &queued_counter, read, (uint8_t *) samples, sizeof(samples)) != 4 * sizeof(uint32_t)
+            || samples[0] != 1 || samples[3] != 4
+            || rpc_call_timed(TIMEOUT, &queued_counter, read, (uint8_t *) samples, sizeof(samples)) != 0)
+    {
+        TEST_FAIL();
+    }
+
+    if (rpc_call_timed(TIMEOUT, &latest_counter, read, (uint8_t *) samples, sizeof(samples)) != sizeof(uint32_t)
+            || samples[0] != 4
+            || rpc_call_timed(TIMEOUT, &latest_counter, read, (uint8_t *) samples, sizeof(samples)) != 0)
+    {
+        TEST_FAIL();
+    }
+
+    /* Consumer read everything, next batch notifies again */
+    samples[0] = 5;
+    rpc_call(&counter, write, (const uint8_t *) samples, sizeof(uint32_t));
+    usleep(10000);
+    if (notifications != 2)
+    {
+        TEST_FAIL();
+    }
+
+    TEST_SUCCESS();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(com_bus_client, 0x40000000, 0x60000000);
+OS_APPLICATION(com_bus_client);
+OS_THREAD_CREATE(com_bus_client, client_main, NULL, 2);
+OS_RPC_WORKER(com_bus_client, worker0, 4);
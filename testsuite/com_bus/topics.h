@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cmrx/bsw/com/bus.h>
+
+extern struct ComSubscription queued_counter;
+extern struct ComSubscription latest_counter;
+extern struct ComTopic counter;
+extern struct ComBus test_bus;
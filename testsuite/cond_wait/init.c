@@ -0,0 +1,68 @@
+#include <cmrx/ipc/thread.h>
+#include <cmrx/ipc/cond.h>
+#include <cmrx/application.h>
+#include <debug.h>
+
+static futex_t lock = FUTEX_STATIC_INIT;
+static cond_t cond = COND_STATIC_INIT;
+static int ready = 0;
+static int woken = 0;
+
+int waiter_main(void *)
+{
+    futex_lock(&lock);
+    while (!ready)
+    {
+        cond_wait(&cond, &lock, WAIT_FOREVER);
+    }
+    woken++;
+    futex_unlock(&lock);
+    return 0;
+}
+
+int init_main(void *)
+{
+    /* Nobody signals */
+    futex_lock(&lock);
+    if (cond_wait(&cond, &lock, 2000) != E_TIMEOUT || lock.owner != get_tid())
+    {
+        TEST_FAIL();
+    }
+    futex_unlock(&lock);
+
+    int threads[3];
+    for (int q = 0; q < 3; ++q)
+    {
+        threads[q] = thread_create(waiter_main, NULL, 32);
+    }
+
+    /* Single signal without condition being set, waiter goes back to sleep */
+    cond_signal(&cond);
+    if (woken != 0)
+    {
+        TEST_FAIL();
+    }
+
+    /* Broadcast wakes one, others are woken one by one by futex unlocks */
+    futex_lock(&lock);
+    ready = 1;
+    cond_broadcast(&cond);
+    futex_unlock(&lock);
+
+    for (int q = 0; q < 3; ++q)
+    {
+        thread_join(threads[q]);
+    }
+
+    if (woken != 3)
+    {
+        TEST_FAIL();
+    }
+
+    TEST_SUCCESS();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(cond_wait_init, 0x40000000, 0x60000000);
+OS_APPLICATION(cond_wait_init);
+OS_THREAD_CREATE(cond_wait_init, init_main, NULL, 64);
@@ -15,3 +15,15 @@ void TEST_STEP(unsigned step)
     return;
 }
 
+void BENCH_START()
+{
+    return;
+}
+
+void BENCH_STOP(const char * name, unsigned iterations)
+{
+    (void) name;
+    (void) iterations;
+    return;
+}
+
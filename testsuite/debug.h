@@ -3,3 +3,5 @@
 void TEST_SUCCESS();
 void TEST_FAIL();
 void TEST_STEP(unsigned step);
+void BENCH_START();
+void BENCH_STOP(const char * name, unsigned iterations);
@@ -0,0 +1,129 @@
+#include <cmrx/ipc/thread.h>
+#include <cmrx/ipc/event.h>
+#include <cmrx/ipc/timer.h>
+#include <cmrx/ipc/wait.h>
+#include <cmrx/application.h>
+#include <debug.h>
+
+static int group;
+static uint32_t all_bits = 0;
+static uint32_t any_bits = 0;
+static int objects_rv = 0;
+static int deleted_rv = 0;
+
+int all_main(void *)
+{
+    /* Waits until both flags are set, consumes them */
+    uint32_t bits = 0x3;
+    if (event_group_wait(group, &bits, EVENT_WAIT_ALL | EVENT_WAIT_CLEAR, WAIT_FOREVER) == E_OK)
+    {
+        all_bits = bits;
+    }
+    return 0;
+}
+
+int any_main(void *)
+{
+    uint32_t bits = 0x6;
+    if (event_group_wait(group, &bits, EVENT_WAIT_ANY, WAIT_FOREVER) == E_OK)
+    {
+        any_bits = bits;
+    }
+    return 0;
+}
+
+int deleted_main(void *)
+{
+    uint32_t bits = 0x8;
+    deleted_rv = event_group_wait(group, &bits, EVENT_WAIT_ANY, WAIT_FOREVER);
+    return 0;
+}
+
+int objects_main(void *)
+{
+    struct WaitObject objects[] = {
+        WAIT_ON_EVENT_GROUP(group, 0x8, EVENT_WAIT_ANY)
+    };
+    objects_rv = wait_objects(objects, 1, WAIT_FOREVER);
+    return 0;
+}
+
+int init_main(void *)
+{
+    group = event_group_create();
+    if (group < 0)
+    {
+        TEST_FAIL();
+    }
+
+    /* Nothing set yet, poll and timed wait both time out */
+    uint32_t bits = 0x1;
+    if (event_group_wait(group, &bits, EVENT_WAIT_ANY, 0) != E_TIMEOUT
+            || event_group_wait(group, &bits, EVENT_WAIT_ANY, 2000) != E_TIMEOUT
+            || bits != 0x1)
+    {
+        TEST_FAIL();
+    }
+
+    /* Invalid handle is not mistaken for timeout */
+    if (event_group_wait(group + 1, &bits, EVENT_WAIT_ANY, 0) != E_INVALID)
+    {
+        TEST_FAIL();
+    }
+
+    /* Higher priority waiter needs all flags, lower one any of them */
+    thread_create(all_main, NULL, 16);
+    thread_create(any_main, NULL, 32);
+    sched_yield();
+
+    /* Not enough for ALL waiter, nothing for ANY waiter */
+    event_group_set(group, 0x1);
+    if (all_bits != 0 || any_bits != 0)
+    {
+        TEST_FAIL();
+    }
+
+    /* Wakes ALL waiter which clears 0x3; 0x4 wakes ANY waiter */
+    event_group_set(group, 0x6);
+    usleep(1000);
+    if (all_bits != 0x7 || any_bits != 0x4)
+    {
+        TEST_FAIL();
+    }
+
+    /* Auto-clear removed only flags waited for */
+    bits = 0xFFFFFFFF;
+    if (event_group_wait(group, &bits, EVENT_WAIT_ANY, 0) != E_OK || bits != 0x4)
+    {
+        TEST_FAIL();
+    }
+
+    event_group_clear(group, 0x4);
+    bits = 0x4;
+    if (event_group_wait(group, &bits, EVENT_WAIT_ANY, 0) != E_TIMEOUT)
+    {
+        TEST_FAIL();
+    }
+
+    /* Deletion is not mistaken for group becoming ready or timeout */
+    thread_create(objects_main, NULL, 16);
+    thread_create(deleted_main, NULL, 16);
+    sched_yield();
+
+    if (event_group_delete(group) != E_OK || event_group_set(group, 0x1) != E_INVALID)
+    {
+        TEST_FAIL();
+    }
+
+    if (objects_rv != -E_DELETED || deleted_rv != E_DELETED)
+    {
+        TEST_FAIL();
+    }
+
+    TEST_SUCCESS();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(event_group_init, 0x40000000, 0x60000000);
+OS_APPLICATION(event_group_init);
+OS_THREAD_CREATE(event_group_init, init_main, NULL, 64);
@@ -0,0 +1,39 @@
+#include <cmrx/ipc/thread.h>
+#include <cmrx/ipc/mutex.h>
+#include <cmrx/application.h>
+#include <debug.h>
+
+static futex_t lock = FUTEX_CEILING_INIT(16);
+static int mid_ran = 0;
+
+int mid_main(void *)
+{
+    mid_ran = 1;
+    return 0;
+}
+
+int init_main(void *)
+{
+    futex_lock(&lock);
+
+    /* Owner runs at ceiling, higher priority thread doesn't preempt it */
+    thread_create(mid_main, NULL, 32);
+    if (mid_ran != 0)
+    {
+        TEST_FAIL();
+    }
+
+    /* Unlocking restores priority, created thread preempts us now */
+    futex_unlock(&lock);
+    if (mid_ran != 1)
+    {
+        TEST_FAIL();
+    }
+
+    TEST_SUCCESS();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(futex_ceiling_init, 0x40000000, 0x60000000);
+OS_APPLICATION(futex_ceiling_init);
+OS_THREAD_CREATE(futex_ceiling_init, init_main, NULL, 64);
@@ -0,0 +1,52 @@
+#include <cmrx/ipc/thread.h>
+#include <cmrx/ipc/mutex.h>
+#include <cmrx/ipc/timer.h>
+#include <cmrx/application.h>
+#include <debug.h>
+
+static uint32_t word = 0;
+
+int waiter_main(void *)
+{
+    /* Word doesn't contain expected value */
+    if (futex_wait(&word, 1, WAIT_FOREVER) != E_BUSY)
+    {
+        TEST_FAIL();
+    }
+
+    /* Nobody wakes us up */
+    if (futex_wait(&word, 0, 2000) != E_TIMEOUT)
+    {
+        TEST_FAIL();
+    }
+
+    /* Woken up by init thread */
+    if (futex_wait(&word, 0, WAIT_FOREVER) != E_OK || word != 1)
+    {
+        TEST_FAIL();
+    }
+
+    TEST_SUCCESS();
+    return 0;
+}
+
+int init_main(void *)
+{
+    thread_create(waiter_main, NULL, 32);
+    sched_yield();
+
+    /* Let the timed wait expire, waiter is blocked without timeout then */
+    usleep(5000);
+
+    word = 1;
+    if (futex_wake(&word, 1) != 1)
+    {
+        TEST_FAIL();
+    }
+    TEST_FAIL();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(futex_wait_init, 0x40000000, 0x60000000);
+OS_APPLICATION(futex_wait_init);
+OS_THREAD_CREATE(futex_wait_init, init_main, NULL, 64);
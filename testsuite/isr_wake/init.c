@@ -0,0 +1,53 @@
+#include <cmrx/ipc/thread.h>
+#include <cmrx/ipc/notify.h>
+#include <cmrx/application.h>
+#include <debug.h>
+
+/* Shared with SysTick handler in main.c */
+volatile uint32_t isr_wake_ticks = 0;
+volatile int isr_wake_armed = 0;
+volatile Thread_t isr_wake_consumer;
+
+static void wait_tick(void)
+{
+    uint32_t ticks = isr_wake_ticks;
+    while (isr_wake_ticks == ticks);
+}
+
+int init_main(void *)
+{
+    isr_wake_consumer = get_tid();
+
+    /* Calibrate how many loops fit between two interrupts */
+    wait_tick();
+    uint32_t ticks = isr_wake_ticks;
+    volatile unsigned loops = 0;
+    while (isr_wake_ticks == ticks)
+    {
+        loops++;
+    }
+
+    /* Enter notify_take() at various moments before the interrupt, so that
+     * it fires while this thread is blocking in there and the task switch
+     * is still pending. The notification must never get lost.
+     */
+    unsigned step = 1 + loops / 512;
+    for (unsigned delay = loops; delay >= step; delay -= step)
+    {
+        wait_tick();
+        for (volatile unsigned q = 0; q < delay; q++);
+
+        isr_wake_armed = 1;
+        if (notify_take(0, true, WAIT_FOREVER) != 1)
+        {
+            TEST_FAIL();
+        }
+    }
+
+    TEST_SUCCESS();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(isr_wake_init, 0x40000000, 0x60000000);
+OS_APPLICATION(isr_wake_init);
+OS_THREAD_CREATE(isr_wake_init, init_main, NULL, 64);
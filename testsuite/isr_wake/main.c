@@ -0,0 +1,54 @@
+#include <cmrx/os/sched.h>
+#include <cmrx/clock.h>
+#include <cmrx/ipc/isr.h>
+#include <debug.h>
+#include <RTE_Components.h>
+#include CMSIS_device_header
+
+/* This test provides its own timing provider, so SysTick serves as
+ * a plain interrupt source, which posts requests to the kernel. Kernel timing
+ * services are not used by the test.
+ */
+
+extern volatile uint32_t isr_wake_ticks;
+extern volatile int isr_wake_armed;
+extern volatile Thread_t isr_wake_consumer;
+
+void SysTick_Handler()
+{
+    isr_wake_ticks++;
+    if (isr_wake_armed)
+    {
+        isr_wake_armed = 0;
+        isr_notify_give(isr_wake_consumer, 0);
+    }
+}
+
+void timing_provider_schedule(long delay_us)
+{
+    (void) delay_us;
+}
+
+void timing_provider_delay(long delay_us)
+{
+    volatile uint32_t cycles_count = (SystemCoreClock / 1000000) * delay_us;
+
+    do {
+    } while((cycles_count--) > 0);
+}
+
+int main(void)
+{
+    /* Usual setup, where PendSV has lowest priority. Interrupt requests
+     * become pending while thread is inside syscall and are serviced before
+     * thread is switched out.
+     */
+    NVIC_SetPriority(PendSV_IRQn, (1 << __NVIC_PRIO_BITS) - 1);
+    SysTick_Config(SystemCoreClock / 10000);
+    NVIC_SetPriority(SysTick_IRQn, (1 << __NVIC_PRIO_BITS) - 2);
+	os_start();
+    TEST_FAIL();
+    TEST_STEP(0);
+    BENCH_START();
+    BENCH_STOP("", 1);
+}
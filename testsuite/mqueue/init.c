@@ -0,0 +1,113 @@
+#include <cmrx/ipc/thread.h>
+#include <cmrx/ipc/mqueue.h>
+#include <cmrx/application.h>
+#include <debug.h>
+
+static int queue;
+static int stage = 0;
+
+int receiver_main(void *)
+{
+    uint32_t message = 0;
+
+    /* Blocks until sender hands message over */
+    stage = 1;
+    if (mqueue_receive(queue, &message, WAIT_FOREVER) != E_OK || message != 0x1234)
+    {
+        TEST_FAIL();
+    }
+
+    /* Zero-copy receive of queued message */
+    const uint32_t * mapped = NULL;
+    stage = 2;
+    if (mqueue_receive_map(queue, (const void **) &mapped, WAIT_FOREVER) != E_OK || *mapped != 0x5678)
+    {
+        TEST_FAIL();
+    }
+
+    if (mqueue_release() != E_OK || mqueue_release() != E_INVALID)
+    {
+        TEST_FAIL();
+    }
+
+    stage = 3;
+    return 0;
+}
+
+int init_main(void *)
+{
+    uint32_t message = 0;
+
+    if (mqueue_create(0, 4) >= 0 || mqueue_create(1, 4096) >= 0)
+    {
+        TEST_FAIL();
+    }
+
+    queue = mqueue_create(2, sizeof(uint32_t));
+    if (queue < 0)
+    {
+        TEST_FAIL();
+    }
+
+    /* Kernel refuses memory thread can't access itself */
+    if (mqueue_send(queue, (const void *) 0xE000ED00, 0) != E_INVALID_ADDRESS
+            || mqueue_receive(queue, (void *) 0xE000ED00, 0) != E_INVALID_ADDRESS)
+    {
+        TEST_FAIL();
+    }
+
+    /* Empty queue */
+    if (mqueue_receive(queue, &message, 0) != E_TIMEOUT || mqueue_receive(queue, &message, 2000) != E_TIMEOUT)
+    {
+        TEST_FAIL();
+    }
+
+    /* Messages are received in order they were sent, full queue rejects */
+    message = 1;
+    mqueue_send(queue, &message, 0);
+    message = 2;
+    mqueue_send(queue, &message, 0);
+    if (mqueue_send(queue, &message, 0) != E_TIMEOUT || mqueue_send(queue, &message, 2000) != E_TIMEOUT)
+    {
+        TEST_FAIL();
+    }
+
+    if (mqueue_receive(queue, &message, 0) != E_OK || message != 1
+            || mqueue_receive(queue, &message, 0) != E_OK || message != 2)
+    {
+        TEST_FAIL();
+    }
+
+    /* Higher priority receiver runs at once and blocks */
+    thread_create(receiver_main, NULL, 32);
+    if (stage != 1)
+    {
+        TEST_FAIL();
+    }
+
+    message = 0x1234;
+    mqueue_send(queue, &message, WAIT_FOREVER);
+    if (stage != 2)
+    {
+        TEST_FAIL();
+    }
+
+    message = 0x5678;
+    mqueue_send(queue, &message, WAIT_FOREVER);
+    if (stage != 3)
+    {
+        TEST_FAIL();
+    }
+
+    if (mqueue_delete(queue) != E_OK || mqueue_send(queue, &message, 0) != E_INVALID)
+    {
+        TEST_FAIL();
+    }
+
+    TEST_SUCCESS();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(mqueue_init, 0x40000000, 0x60000000);
+OS_APPLICATION(mqueue_init);
+OS_THREAD_CREATE(mqueue_init, init_main, NULL, 64);
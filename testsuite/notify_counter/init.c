@@ -0,0 +1,64 @@
+#include <cmrx/ipc/thread.h>
+#include <cmrx/ipc/notify.h>
+#include <cmrx/application.h>
+#include <debug.h>
+
+static int stage = 0;
+
+int worker_main(void *)
+{
+    /* Nothing was given yet */
+    if (notify_take(0, false, 0) != 0 || notify_take(0, false, 2000) != 0)
+    {
+        TEST_FAIL();
+    }
+
+    stage = 1;
+    if (notify_take(0, false, WAIT_FOREVER) != 1)
+    {
+        TEST_FAIL();
+    }
+
+    /* Notifications given meanwhile are counted */
+    stage = 2;
+    if (notify_take(1, true, WAIT_FOREVER) != 1 || notify_take(0, true, 0) != 3
+            || notify_take(0, true, 0) != 0)
+    {
+        TEST_FAIL();
+    }
+
+    TEST_SUCCESS();
+    return 0;
+}
+
+int init_main(void *)
+{
+    int worker = thread_create(worker_main, NULL, 32);
+
+    if (notify_give(worker, 100) != E_INVALID)
+    {
+        TEST_FAIL();
+    }
+
+    while (stage != 1)
+    {
+        sched_yield();
+    }
+    notify_give(worker, 0);
+
+    if (stage != 2)
+    {
+        TEST_FAIL();
+    }
+    notify_give(worker, 0);
+    notify_give(worker, 0);
+    notify_give(worker, 0);
+    notify_give(worker, 1);
+
+    TEST_FAIL();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(notify_counter_init, 0x40000000, 0x60000000);
+OS_APPLICATION(notify_counter_init);
+OS_THREAD_CREATE(notify_counter_init, init_main, NULL, 64);
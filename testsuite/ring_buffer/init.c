@@ -0,0 +1,72 @@
+#include <cmrx/ipc/thread.h>
+#include <cmrx/ipc/ring.h>
+#include <cmrx/ipc/shmem.h>
+#include <cmrx/application.h>
+#include <debug.h>
+
+static uint16_t SHARED storage[8];
+static ring_t SHARED ring = RING_STATIC_INIT(storage, sizeof(uint16_t), 8);
+static int stage = 0;
+
+int consumer_main(void *)
+{
+    uint16_t items[8];
+
+    /* Sleeps until ring becomes non-empty */
+    stage = 1;
+    if (ring_pop_wait(&ring, items, 8, WAIT_FOREVER) != 3
+            || items[0] != 10 || items[1] != 11 || items[2] != 12)
+    {
+        TEST_FAIL();
+    }
+
+    stage = 2;
+    return 0;
+}
+
+int init_main(void *)
+{
+    uint16_t items[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    uint16_t popped[10];
+
+    if (ring_pop(&ring, popped, 10) != 0 || ring_pop_wait(&ring, popped, 10, 2000) != 0)
+    {
+        TEST_FAIL();
+    }
+
+    /* Only as many items as fit are pushed */
+    if (ring_push(&ring, items, 10) != 8 || ring_count(&ring) != 8 || ring_push(&ring, items, 1) != 0)
+    {
+        TEST_FAIL();
+    }
+
+    /* Batches wrap around end of storage */
+    if (ring_pop(&ring, popped, 5) != 5 || ring_push_multi(&ring, &items[8], 2) != 2
+            || ring_pop(&ring, popped, 10) != 5 || popped[2] != 7 || popped[3] != 8 || popped[4] != 9)
+    {
+        TEST_FAIL();
+    }
+
+    thread_create(consumer_main, NULL, 32);
+    if (stage != 1)
+    {
+        TEST_FAIL();
+    }
+
+    /* Transition from empty wakes consumer */
+    items[0] = 10;
+    items[1] = 11;
+    items[2] = 12;
+    ring_push(&ring, items, 3);
+    if (stage != 2)
+    {
+        TEST_FAIL();
+    }
+
+    TEST_SUCCESS();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(ring_buffer_init, 0x40000000, 0x60000000);
+OS_APPLICATION(ring_buffer_init);
+OS_THREAD_CREATE(ring_buffer_init, init_main, NULL, 64);
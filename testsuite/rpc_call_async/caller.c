@@ -0,0 +1,40 @@
+#include <cmrx/application.h>
+#include <cmrx/ipc/thread.h>
+#include <cmrx/ipc/rpc.h>
+#include <cmrx/ipc/signal.h>
+#include <debug.h>
+#include "service.h"
+
+static int token;
+
+void completion_handler(uint32_t signo, uint32_t value)
+{
+    (void) signo;
+    (void) value;
+    int retval = 0;
+
+    if (rpc_poll(token, &retval) == E_OK && retval == 2)
+    {
+        TEST_SUCCESS();
+    }
+    TEST_FAIL();
+}
+
+int caller_high_prio(void * data)
+{
+    (void) data;
+
+    signal(1, completion_handler);
+    token = rpc_call_async(1, &service, method, 1);
+    if (token < 0)
+    {
+        TEST_FAIL();
+    }
+    kill(get_tid(), SIGSTOP);
+	TEST_FAIL();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(rpc_call_async_caller, 0x40000000, 0x60000000);
+OS_APPLICATION(rpc_call_async_caller);
+OS_THREAD_CREATE(rpc_call_async_caller, caller_high_prio, NULL, 2);
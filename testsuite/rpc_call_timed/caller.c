@@ -0,0 +1,22 @@
+#include <cmrx/application.h>
+#include <cmrx/ipc/thread.h>
+#include <cmrx/ipc/rpc.h>
+#include <debug.h>
+#include "service.h"
+
+int caller_high_prio(void * data)
+{
+    (void) data;
+
+    int retval = rpc_call_timed(10000, &service, method, 1);
+    if (retval == E_TIMEOUT)
+    {
+        TEST_SUCCESS();
+    }
+	TEST_FAIL();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(rpc_call_timed_caller, 0x40000000, 0x60000000);
+OS_APPLICATION(rpc_call_timed_caller);
+OS_THREAD_CREATE(rpc_call_timed_caller, caller_high_prio, NULL, 2);
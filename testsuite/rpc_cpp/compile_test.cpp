@@ -0,0 +1,41 @@
+/* Compile-only test of the C++ RPC layer. It is not a firmware test, it only
+ * has to build, so that changes to rpc.hpp or the C RPC headers which break
+ * the C++ wrapper are caught.
+ */
+#include <cmrx/rpc/rpc.hpp>
+
+struct Counter {
+    using add = cmrx::rpc::Method<Counter, 0, int(uint32_t)>;
+    using get = cmrx::rpc::Method<Counter, 1, int()>;
+    using reset = cmrx::rpc::Method<Counter, 2, void()>;
+    using name = cmrx::rpc::Method<Counter, 3, const char *(unsigned, unsigned)>;
+    using methods = cmrx::rpc::Methods<add, get, reset, name>;
+};
+
+class MyCounter : public cmrx::rpc::Service<Counter> {
+public:
+    using Service::Service;
+    int add(uint32_t value) { total += value; return total; }
+    int get() const { return total; }
+    void reset() noexcept { total = 0; }
+    const char * name(unsigned a, unsigned b) const noexcept { return (a + b) ? "counter" : nullptr; }
+private:
+    uint32_t total = 0;
+};
+
+CMRX_RPC_VTABLE constexpr auto my_counter_vtable = cmrx::rpc::vtable<Counter, MyCounter,
+    &MyCounter::add, &MyCounter::get, &MyCounter::reset, &MyCounter::name>();
+
+MyCounter counter(my_counter_vtable);
+
+static_assert(sizeof(my_counter_vtable) == 4 * sizeof(void *), "VTable must have C layout");
+static_assert(std::is_standard_layout_v<decltype(my_counter_vtable)>, "VTable must have C layout");
+
+int rpc_cpp_compile_test()
+{
+    int total = cmrx::rpc::call<Counter::add>(&counter, 5);
+    total += cmrx::rpc::call<Counter::get>(&counter);
+    cmrx::rpc::call<Counter::reset>(&counter);
+    const char * text = cmrx::rpc::call<Counter::name>(&counter, 1, 2);
+    return text != nullptr ? total : 0;
+}
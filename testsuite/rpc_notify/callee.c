@@ -0,0 +1,37 @@
+#include <cmrx/application.h>
+#include <cmrx/ipc/thread.h>
+#include <debug.h>
+#include <cmrx/rpc/interface.h>
+#include "service.h"
+
+#include <cmrx/rpc/implementation.h>
+
+IMPLEMENTATION_OF(struct Service, struct ServiceVTable);
+
+uint32_t service_method(INSTANCE(this), uint32_t arg1)
+{
+    this->value++;
+    if (arg1 == 2)
+    {
+        // Two identical notifications were merged into one
+        if (this->value == 2)
+        {
+            TEST_SUCCESS();
+        }
+        TEST_FAIL();
+    }
+    return 0;
+}
+
+VTABLE struct ServiceVTable service_vtable = {
+    service_method
+};
+
+struct Service service = {
+    &service_vtable,
+    0
+};
+
+OS_APPLICATION_MMIO_RANGE(rpc_notify_callee, 0x40000000, 0x60000000);
+OS_APPLICATION(rpc_notify_callee);
+OS_RPC_WORKER(rpc_notify_callee, worker0, 4);
@@ -0,0 +1,25 @@
+#include <cmrx/application.h>
+#include <cmrx/ipc/thread.h>
+#include <cmrx/ipc/rpc.h>
+#include <cmrx/ipc/signal.h>
+#include <debug.h>
+#include "service.h"
+
+int caller_high_prio(void * data)
+{
+    (void) data;
+
+    if (rpc_notify(&service, method, 1) != E_OK
+        || rpc_notify(&service, method, 1) != E_OK
+        || rpc_notify(&service, method, 2) != E_OK)
+    {
+        TEST_FAIL();
+    }
+    kill(get_tid(), SIGSTOP);
+	TEST_FAIL();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(rpc_notify_caller, 0x40000000, 0x60000000);
+OS_APPLICATION(rpc_notify_caller);
+OS_THREAD_CREATE(rpc_notify_caller, caller_high_prio, NULL, 2);
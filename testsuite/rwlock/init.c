@@ -0,0 +1,55 @@
+#include <cmrx/ipc/thread.h>
+#include <cmrx/ipc/rwlock.h>
+#include <cmrx/application.h>
+#include <debug.h>
+
+static rwlock_t lock = RWLOCK_STATIC_INIT;
+static int written = 0;
+
+int writer_main(void *)
+{
+    rwlock_write_lock(&lock);
+    written = 1;
+    rwlock_write_unlock(&lock);
+    return 0;
+}
+
+int init_main(void *)
+{
+    /* Multiple readers at once, no writer meanwhile */
+    if (rwlock_read_lock(&lock) != 0 || rwlock_read_trylock(&lock) != 0
+            || rwlock_write_trylock(&lock) != E_BUSY)
+    {
+        TEST_FAIL();
+    }
+    rwlock_read_unlock(&lock);
+
+    /* Writer blocks on reader */
+    int writer = thread_create(writer_main, NULL, 32);
+    if (written != 0)
+    {
+        TEST_FAIL();
+    }
+
+    /* Waiting writer holds off new readers */
+    if (rwlock_read_trylock(&lock) != E_BUSY)
+    {
+        TEST_FAIL();
+    }
+
+    /* Last reader hands lock over to writer */
+    rwlock_read_unlock(&lock);
+    thread_join(writer);
+    if (written != 1 || rwlock_write_trylock(&lock) != 0)
+    {
+        TEST_FAIL();
+    }
+    rwlock_write_unlock(&lock);
+
+    TEST_SUCCESS();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(rwlock_test, 0x40000000, 0x60000000);
+OS_APPLICATION(rwlock_test);
+OS_THREAD_CREATE(rwlock_test, init_main, NULL, 64);
@@ -0,0 +1,59 @@
+#include <cmrx/ipc/thread.h>
+#include <cmrx/ipc/sem.h>
+#include <cmrx/application.h>
+#include <debug.h>
+
+static sem_t sem = SEM_STATIC_INIT(2);
+static int stage = 0;
+
+int worker_main(void *)
+{
+    stage = 1;
+    if (sem_take(&sem, WAIT_FOREVER) != E_OK)
+    {
+        TEST_FAIL();
+    }
+    stage = 2;
+    return 0;
+}
+
+int init_main(void *)
+{
+    /* Initial units are available without blocking */
+    if (sem_take(&sem, 0) != E_OK || sem_take(&sem, 0) != E_OK)
+    {
+        TEST_FAIL();
+    }
+
+    if (sem_take(&sem, 0) != E_TIMEOUT || sem_take(&sem, 2000) != E_TIMEOUT)
+    {
+        TEST_FAIL();
+    }
+
+    /* Higher priority worker runs at once and blocks, give wakes it up */
+    thread_create(worker_main, NULL, 32);
+    if (stage != 1 || (sem.value & SEM_WAITERS) == 0)
+    {
+        TEST_FAIL();
+    }
+
+    sem_give(&sem);
+    if (stage != 2 || sem.value != 0)
+    {
+        TEST_FAIL();
+    }
+
+    /* Unit given without waiters is kept */
+    sem_give(&sem);
+    if (sem.value != 1 || sem_take(&sem, WAIT_FOREVER) != E_OK)
+    {
+        TEST_FAIL();
+    }
+
+    TEST_SUCCESS();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(semaphore_init, 0x40000000, 0x60000000);
+OS_APPLICATION(semaphore_init);
+OS_THREAD_CREATE(semaphore_init, init_main, NULL, 64);
@@ -0,0 +1,46 @@
+#include <cmrx/application.h>
+#include <cmrx/ipc/rpc.h>
+#include <cmrx/ipc/shmem.h>
+#include <debug.h>
+#include "service.h"
+
+static uint32_t channel[64] __attribute__((aligned(256)));
+
+int owner_main(void *)
+{
+    const struct OS_process_definition_t * peer = SHMEM_PROCESS(shmem_window_peer);
+    const struct OS_process_definition_t * self = SHMEM_PROCESS(shmem_window_owner);
+
+    if (shmem_window_open(self, channel, sizeof(channel), 0) != -E_INVALID
+            || shmem_window_open(peer, channel, 100, 0) != -E_MISALIGNED
+            || shmem_window_open(peer, &channel[1], sizeof(channel), 0) != -E_MISALIGNED
+            || shmem_window_open(peer, (void *) 0x20000000, 0x10000, 0) != -E_INVALID_ADDRESS)
+    {
+        TEST_FAIL();
+    }
+
+    int window = shmem_window_open(peer, channel, sizeof(channel), 0);
+    if (window < 0 || shmem_window_open(peer, channel, sizeof(channel), 0) != -E_BUSY)
+    {
+        TEST_FAIL();
+    }
+
+    channel[0] = 0xCAFEBABE;
+    int retval = rpc_call_timed(100000, &service, method, (uint32_t) channel);
+    if ((uint32_t) retval != 0xCAFEBABE)
+    {
+        TEST_FAIL();
+    }
+
+    if (shmem_window_close(window) != E_OK || shmem_window_close(window) != E_INVALID)
+    {
+        TEST_FAIL();
+    }
+
+    TEST_SUCCESS();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(shmem_window_owner, 0x40000000, 0x60000000);
+OS_APPLICATION(shmem_window_owner);
+OS_THREAD_CREATE(shmem_window_owner, owner_main, NULL, 2);
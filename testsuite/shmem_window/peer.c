@@ -0,0 +1,28 @@
+#include <cmrx/application.h>
+#include <debug.h>
+#include <cmrx/rpc/interface.h>
+#include "service.h"
+
+#include <cmrx/rpc/implementation.h>
+
+IMPLEMENTATION_OF(struct Service, struct ServiceVTable);
+
+uint32_t service_method(INSTANCE(this), uint32_t arg1)
+{
+    /* Window of owner is readable while in peer process */
+    const volatile uint32_t * window = (const uint32_t *) arg1;
+    this->value = window[0];
+    return this->value;
+}
+
+VTABLE struct ServiceVTable service_vtable = {
+    service_method
+};
+
+struct Service service = {
+    &service_vtable,
+    0
+};
+
+OS_APPLICATION_MMIO_RANGE(shmem_window_peer, 0x40000000, 0x60000000);
+OS_APPLICATION(shmem_window_peer);
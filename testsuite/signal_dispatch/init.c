@@ -0,0 +1,63 @@
+#include <cmrx/ipc/thread.h>
+#include <cmrx/application.h>
+#include <debug.h>
+#include <cmrx/ipc/signal.h>
+
+#define SIG_FIRST       4
+#define SIG_SECOND      9
+
+static unsigned handled = 0;
+static uint32_t handled_signals[2];
+
+void first_handler(uint32_t signo, uint32_t value)
+{
+    (void) value;
+    if (signo != SIG_FIRST || handled >= 2)
+    {
+        TEST_FAIL();
+    }
+    handled_signals[handled++] = signo;
+}
+
+void second_handler(uint32_t signo, uint32_t value)
+{
+    (void) value;
+    if (signo != SIG_SECOND || handled >= 2)
+    {
+        TEST_FAIL();
+    }
+    handled_signals[handled++] = signo;
+}
+
+int thread_main(void *)
+{
+    signal(SIG_FIRST, first_handler);
+    signal(SIG_SECOND, second_handler);
+
+    /* Both signals are pending at once when thread gets scheduled in again.
+     * Lower signal number is dispatched first regardless of order of arrival.
+     */
+    kill(get_tid(), SIG_SECOND);
+    kill(get_tid(), SIG_FIRST);
+    kill(get_tid(), SIGSTOP);
+
+    if (handled == 2 && handled_signals[0] == SIG_FIRST && handled_signals[1] == SIG_SECOND)
+    {
+        TEST_SUCCESS();
+    }
+    TEST_FAIL();
+    return 0;
+}
+
+int init_main(void *)
+{
+    int thread_id = thread_create(thread_main, NULL, 32);
+    sched_yield();
+    kill(thread_id, SIGCONT);
+    TEST_FAIL();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(signal_dispatch_init, 0x40000000, 0x60000000);
+OS_APPLICATION(signal_dispatch_init);
+OS_THREAD_CREATE(signal_dispatch_init, init_main, NULL, 64);
@@ -3,9 +3,10 @@
 #include <debug.h>
 #include <cmrx/ipc/signal.h>
 
-void signal_handler(uint32_t signo)
+void signal_handler(uint32_t signo, uint32_t value)
 {
     (void) signo;
+    (void) value;
     TEST_SUCCESS();
 }
 
@@ -0,0 +1,77 @@
+#include <cmrx/ipc/thread.h>
+#include <cmrx/application.h>
+#include <cmrx/defines.h>
+#include <debug.h>
+#include <cmrx/ipc/signal.h>
+
+static unsigned handled = 0;
+static uint32_t handled_signals[4];
+static uint32_t handled_values[4];
+
+void signal_handler(uint32_t signo, uint32_t value)
+{
+    if (handled < 4)
+    {
+        handled_signals[handled] = signo;
+        handled_values[handled] = value;
+    }
+    handled++;
+}
+
+int thread_main(void *)
+{
+    static const uint32_t values[4] = { 0x11, 0x22, 0x22, 0x44 };
+    static const uint32_t signals[4] = { 1, 2, 2, 3 };
+
+    for (int q = 1; q <= 3; ++q)
+    {
+        signal(q, signal_handler);
+    }
+
+    /* Queue signals to ourselves. They will be delivered next time
+     * this thread gets scheduled in.
+     */
+    for (int q = 0; q < 4; ++q)
+    {
+        if (sigqueue(get_tid(), signals[q], values[q]) != 0)
+        {
+            TEST_FAIL();
+        }
+    }
+
+    if (sigqueue(get_tid(), 5, 0x55) != E_BUSY)
+    {
+        TEST_FAIL();
+    }
+
+    kill(get_tid(), SIGSTOP);
+
+    if (handled != 4)
+    {
+        TEST_FAIL();
+    }
+
+    for (int q = 0; q < 4; ++q)
+    {
+        if (handled_signals[q] != signals[q] || handled_values[q] != values[q])
+        {
+            TEST_FAIL();
+        }
+    }
+
+    TEST_SUCCESS();
+    return 0;
+}
+
+int init_main(void *)
+{
+    int thread_id = thread_create(thread_main, NULL, 32);
+    sched_yield();
+    kill(thread_id, SIGCONT);
+    TEST_FAIL();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(signal_queue_init, 0x40000000, 0x60000000);
+OS_APPLICATION(signal_queue_init);
+OS_THREAD_CREATE(signal_queue_init, init_main, NULL, 64);
@@ -0,0 +1,43 @@
+#include <cmrx/ipc/thread.h>
+#include <cmrx/application.h>
+#include <debug.h>
+#include <cmrx/ipc/signal.h>
+
+int thread_main(void *)
+{
+    /* Woken up by signal 5, signal 7 remains pending */
+    if ((uint32_t) sigwait((1 << 3) | (1 << 5), WAIT_FOREVER) != (1 << 5))
+    {
+        TEST_FAIL();
+    }
+
+    /* Collect already pending signal without blocking */
+    if ((uint32_t) sigwait(1 << 7, 0) != (1 << 7))
+    {
+        TEST_FAIL();
+    }
+
+    /* Nobody sends signal 3 */
+    if (sigwait(1 << 3, 2000) != 0)
+    {
+        TEST_FAIL();
+    }
+
+    TEST_SUCCESS();
+    return 0;
+}
+
+int init_main(void *)
+{
+    int thread_id = thread_create(thread_main, NULL, 32);
+    sched_yield();
+    kill(thread_id, 7);
+    kill(thread_id, 5);
+    thread_join(thread_id);
+    TEST_FAIL();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(signal_wait_init, 0x40000000, 0x60000000);
+OS_APPLICATION(signal_wait_init);
+OS_THREAD_CREATE(signal_wait_init, init_main, NULL, 64);
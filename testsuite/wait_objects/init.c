@@ -0,0 +1,94 @@
+#include <cmrx/ipc/thread.h>
+#include <cmrx/ipc/wait.h>
+#include <cmrx/ipc/event.h>
+#include <cmrx/ipc/signal.h>
+#include <cmrx/ipc/mutex.h>
+#include <cmrx/application.h>
+#include <debug.h>
+
+static uint32_t word = 0;
+static int group;
+static int stage = 0;
+
+int waiter_main(void *)
+{
+    struct WaitObject objects[] = {
+        WAIT_ON_FUTEX(&word, 0),
+        WAIT_ON_SIGNALS(1 << 3),
+        WAIT_ON_EVENT_GROUP(group, 0x1, EVENT_WAIT_ANY | EVENT_WAIT_CLEAR)
+    };
+
+    /* Kernel refuses futex word thread can't access itself */
+    struct WaitObject foreign[] = {
+        WAIT_ON_FUTEX((uint32_t *) 0xE000ED00, 0)
+    };
+    if (wait_objects(foreign, 1, 0) != -E_INVALID_ADDRESS
+            || futex_wait((uint32_t *) 0xE000ED00, 0, 0) != E_INVALID_ADDRESS)
+    {
+        TEST_FAIL();
+    }
+
+    /* Nothing is ready yet */
+    if (wait_objects(objects, 3, 0) != -E_TIMEOUT
+            || wait_objects(objects, 3, 2000) != -E_TIMEOUT)
+    {
+        TEST_FAIL();
+    }
+
+    /* Signal stays pending after wakeup */
+    stage = 1;
+    if (wait_objects(objects, 3, WAIT_FOREVER) != 1 || sigwait(1 << 3, 0) != (1 << 3))
+    {
+        TEST_FAIL();
+    }
+
+    /* Event group flag is consumed */
+    stage = 2;
+    uint32_t bits = 0x1;
+    if (wait_objects(objects, 3, WAIT_FOREVER) != 2 || event_group_wait(group, &bits, EVENT_WAIT_ANY, 0) != E_TIMEOUT)
+    {
+        TEST_FAIL();
+    }
+
+    stage = 3;
+    if (wait_objects(objects, 3, WAIT_FOREVER) != 0 || word != 1)
+    {
+        TEST_FAIL();
+    }
+
+    TEST_SUCCESS();
+    return 0;
+}
+
+int init_main(void *)
+{
+    group = event_group_create();
+    int waiter = thread_create(waiter_main, NULL, 32);
+    sched_yield();
+
+    while (stage != 1)
+    {
+        sched_yield();
+    }
+    kill(waiter, 3);
+
+    if (stage != 2)
+    {
+        TEST_FAIL();
+    }
+    event_group_set(group, 0x1);
+
+    if (stage != 3)
+    {
+        TEST_FAIL();
+    }
+    word = 1;
+    futex_wake(&word, 1);
+
+    TEST_FAIL();
+	return 0;
+}
+
+OS_APPLICATION_MMIO_RANGE(wait_objects_init, 0x40000000, 0x60000000);
+OS_APPLICATION(wait_objects_init);
+OS_THREAD_CREATE(wait_objects_init, init_main, NULL, 64);
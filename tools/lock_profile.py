@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Print lock contention report out of lock profile dumped from CMRX kernel.
+
+Input is binary blob written by lock-profile-dump GDB command from
+tools/lock_profile.gdb. If ELF image of the firmware is given, lock
+addresses are translated into symbol names.
+
+Usage:
+    lock_profile.py lock_profile.bin [--elf firmware.elf] [--nm arm-none-eabi-nm] [--sort wait]
+"""
+
+import argparse
+import struct
+import sys
+
+from rpc_callgraph import load_symbols, symbolize
+
+LOCK_PROFILE_MAGIC = 0x46504B4C
+LOCK_PROFILE_VERSION = 1
+
+HEADER = struct.Struct("<IHHHHI")
+RECORD = struct.Struct("<IIIIIIIIB3x")
+
+SORT_KEYS = {
+    "wait": lambda s: -s["wait_time"],
+    "contended": lambda s: -s["contended"],
+    "hold": lambda s: -s["hold_max"],
+    "acquisitions": lambda s: -s["acquisitions"],
+}
+
+
+def parse(blob):
+    """Return (times are cycles, dropped events, list of lock statistics)."""
+    if len(blob) < HEADER.size:
+        raise ValueError("input too short")
+    magic, version, record_size, entries, cycles, dropped = HEADER.unpack_from(blob)
+    if magic != LOCK_PROFILE_MAGIC:
+        raise ValueError("not a lock profile, bad magic 0x%08x" % magic)
+    if version != LOCK_PROFILE_VERSION or record_size < RECORD.size:
+        raise ValueError("unsupported lock profile version %d" % version)
+    if len(blob) < HEADER.size + entries * record_size:
+        raise ValueError("input truncated")
+
+    stats = []
+    for q in range(entries):
+        (lock, acquisitions, contended, sleeps, wait_time, hold_max, _acquired,
+         waiters, owner) = RECORD.unpack_from(blob, HEADER.size + q * record_size)
+        if lock == 0:
+            continue
+        stats.append({
+            "lock": lock,
+            "acquisitions": acquisitions,
+            "contended": contended,
+            "sleeps": sleeps,
+            "wait_time": wait_time,
+            "hold_max": hold_max,
+            "waiters": [t for t in range(32) if waiters & (1 << t)],
+            "owner": owner,
+        })
+    return bool(cycles), dropped, stats
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Report lock contention out of CMRX lock profile.")
+    parser.add_argument("blob", help="output of lock-profile-dump GDB command")
+    parser.add_argument("--elf", help="firmware image used to resolve lock names")
+    parser.add_argument("--nm", default="arm-none-eabi-nm", help="nm tool to read ELF symbols")
+    parser.add_argument("--sort", choices=sorted(SORT_KEYS), default="wait", help="column to sort by")
+    args = parser.parse_args()
+
+    with open(args.blob, "rb") as f:
+        try:
+            cycles, dropped, stats = parse(f.read())
+        except ValueError as e:
+            print("%s: %s" % (args.blob, e), file=sys.stderr)
+            return 1
+
+    if not stats:
+        print("No lock statistics found in input", file=sys.stderr)
+        return 1
+
+    symbols = load_symbols(args.elf, args.nm) if args.elf else []
+    unit = "cycles" if cycles else "us"
+
+    print("%-32s %10s %10s %8s %7s %14s %12s %12s %6s  %s" % (
+        "lock", "acquired", "contended", "sleeps", "cont%", "wait " + unit, "avg wait", "max hold",
+        "owner", "waiters"))
+    for s in sorted(stats, key=SORT_KEYS[args.sort]):
+        ratio = 100.0 * s["contended"] / s["acquisitions"] if s["acquisitions"] else 0.0
+        average = s["wait_time"] // s["contended"] if s["contended"] else 0
+        owner = "-" if s["owner"] == 0xFF else str(s["owner"])
+        print("%-32s %10d %10d %8d %6.1f%% %14d %12d %12d %6s  %s" % (
+            symbolize(symbols, s["lock"]), s["acquisitions"], s["contended"], s["sleeps"], ratio,
+            s["wait_time"], average, s["hold_max"], owner, ",".join(map(str, s["waiters"])) or "-"))
+
+    if dropped:
+        print("%d events not accounted, lock profile table is full" % dropped)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
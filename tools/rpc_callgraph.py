@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""Turn RPC statistics and trace dumped from CMRX kernel into call graph.
+
+Input is text produced by GDB commands from tools/rpc_trace.gdb. If ELF
+image of the firmware is given, vtable addresses are translated into
+symbol names.
+
+Usage:
+    rpc_callgraph.py rpc.log [--elf firmware.elf] [--nm arm-none-eabi-nm] [--dot graph.dot]
+"""
+
+import argparse
+import subprocess
+import sys
+from collections import defaultdict
+
+RPC_TRACE_CALL = 0
+RPC_TRACE_RETURN = 1
+RPC_TRACE_ABORT = 2
+
+
+def load_symbols(elf, nm):
+    """Return sorted list of (address, name) of data objects in ELF image."""
+    out = subprocess.run([nm, "-C", elf], check=True, capture_output=True, text=True).stdout
+    symbols = []
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) == 3 and parts[1] in "dDrRbB":
+            symbols.append((int(parts[0], 16), parts[2]))
+    symbols.sort()
+    return symbols
+
+
+def symbolize(symbols, address):
+    """Find name of symbol containing address."""
+    best = None
+    for sym_address, name in symbols:
+        if sym_address > address:
+            break
+        best = (sym_address, name)
+    if best is None:
+        return "0x%08x" % address
+    if best[0] == address:
+        return best[1]
+    return "%s+%d" % (best[1], address - best[0])
+
+
+def parse(lines):
+    stats = []
+    trace = []
+    dropped = 0
+    for line in lines:
+        parts = line.split()
+        if not parts:
+            continue
+        if parts[0] == "STAT" and len(parts) == 7:
+            process, vtable, method, calls, time, time_max = parts[1:]
+            stats.append((int(process), int(vtable, 16), int(method), int(calls), int(time), int(time_max)))
+        elif parts[0] == "TRACE" and len(parts) == 8:
+            timestamp, event, thread, process, depth, vtable, method = parts[1:]
+            trace.append((int(timestamp), int(event), int(thread), int(process), int(depth), int(vtable, 16), int(method)))
+        elif parts[0] == "DROPPED" and len(parts) == 2:
+            dropped = int(parts[1])
+    return stats, trace, dropped
+
+
+def build_graph(trace):
+    """Replay trace and accumulate (caller, callee) edges.
+
+    Returns dictionary of edges keyed by (caller, callee) where each node is
+    (process, vtable, method) or None for thread entry. Values are
+    [calls, inclusive time, exclusive time, aborted calls].
+    """
+    edges = defaultdict(lambda: [0, 0, 0, 0])
+    stacks = defaultdict(list)
+    for timestamp, event, thread, process, depth, vtable, method in trace:
+        node = (process, vtable, method)
+        stack = stacks[thread]
+        if event == RPC_TRACE_CALL:
+            # trace may start in the middle of call chain
+            del stack[depth - 1:]
+            stack.append([node, timestamp, 0])
+            continue
+
+        if not stack or len(stack) != depth or stack[-1][0] != node:
+            # return of call entered before trace started
+            stack.clear()
+            continue
+
+        callee, entered, children = stack.pop()
+        elapsed = (timestamp - entered) & 0xFFFFFFFF
+        caller = stack[-1][0] if stack else None
+        edge = edges[(caller, callee)]
+        edge[0] += 1
+        edge[1] += elapsed
+        edge[2] += elapsed - children
+        if event == RPC_TRACE_ABORT:
+            edge[3] += 1
+        if stack:
+            stack[-1][2] += elapsed
+    return edges
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build RPC call graph out of CMRX RPC trace.")
+    parser.add_argument("log", help="output of rpc-stats-dump and/or rpc-trace-dump GDB commands")
+    parser.add_argument("--elf", help="firmware image used to resolve vtable names")
+    parser.add_argument("--nm", default="arm-none-eabi-nm", help="nm tool to read ELF symbols")
+    parser.add_argument("--dot", help="write call graph in Graphviz format into this file")
+    args = parser.parse_args()
+
+    with open(args.log) as f:
+        stats, trace, dropped = parse(f)
+
+    symbols = load_symbols(args.elf, args.nm) if args.elf else []
+
+    def name(node):
+        if node is None:
+            return "<thread>"
+        process, vtable, method = node
+        return "%s[%d]@%d" % (symbolize(symbols, vtable), method, process)
+
+    if stats:
+        print("%-40s %10s %12s %12s %12s" % ("method", "calls", "inclusive", "average", "max"))
+        for process, vtable, method, calls, time, time_max in sorted(stats, key=lambda s: -s[4]):
+            average = time // calls if calls else 0
+            print("%-40s %10d %12d %12d %12d" % (name((process, vtable, method)), calls, time, average, time_max))
+        if dropped:
+            print("%d calls not accounted, statistics table is full" % dropped)
+        print()
+
+    if trace:
+        edges = build_graph(trace)
+        print("%-40s %-40s %8s %12s %12s %8s" % ("caller", "callee", "calls", "inclusive", "exclusive", "aborted"))
+        for (caller, callee), (calls, inclusive, exclusive, aborted) in sorted(edges.items(), key=lambda e: -e[1][1]):
+            print("%-40s %-40s %8d %12d %12d %8d" % (name(caller), name(callee), calls, inclusive, exclusive, aborted))
+
+        if args.dot:
+            with open(args.dot, "w") as f:
+                f.write("digraph rpc {\n")
+                for (caller, callee), (calls, inclusive, exclusive, aborted) in edges.items():
+                    f.write('    "%s" -> "%s" [label="%d calls\\n%d incl\\n%d excl"];\n'
+                            % (name(caller), name(callee), calls, inclusive, exclusive))
+                f.write("}\n")
+
+    if not stats and not trace:
+        print("No RPC statistics nor trace found in input", file=sys.stderr)
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())